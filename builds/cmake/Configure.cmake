@@ -159,6 +159,7 @@ set(include_files_list
     string.h
     strings.h
     sys/dir.h
+    sys/epoll.h
     sys/file.h
     sys/ioctl.h
     sys/ipc.h
@@ -219,6 +220,7 @@ set(functions_list
     poll
     posix_fadvise
     pread pwrite
+    pwritev
     pthread_cancel
     pthread_keycreate pthread_key_create
     pthread_mutexattr_setprotocol
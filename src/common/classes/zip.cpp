@@ -73,4 +73,77 @@ void ZLib::freeFunc(void*, void* address)
 	MemoryPool::globalFree(address);
 }
 
+
+LZ4::LZ4(Firebird::MemoryPool&)
+{
+#ifdef WIN_NT
+	Firebird::PathName name("lz4.dll");
+#else
+	Firebird::PathName name("liblz4." SHRLIB_EXT ".1");
+#endif
+	z.reset(ModuleLoader::fixAndLoadModule(status, name));
+	if (z)
+		symbols();
+}
+
+void LZ4::symbols()
+{
+#define FB_ZSYMB(A) z->findSymbol(status, STRINGIZE(A), A); if (!A) { z.reset(NULL); return; }
+	FB_ZSYMB(LZ4F_isError)
+	FB_ZSYMB(LZ4F_createCompressionContext)
+	FB_ZSYMB(LZ4F_freeCompressionContext)
+	FB_ZSYMB(LZ4F_compressBound)
+	FB_ZSYMB(LZ4F_compressBegin)
+	FB_ZSYMB(LZ4F_compressUpdate)
+	FB_ZSYMB(LZ4F_flush)
+	FB_ZSYMB(LZ4F_createDecompressionContext)
+	FB_ZSYMB(LZ4F_freeDecompressionContext)
+	FB_ZSYMB(LZ4F_decompress)
+#undef FB_ZSYMB
+}
+
+
+ZStd::ZStd(Firebird::MemoryPool&)
+{
+#ifdef WIN_NT
+	Firebird::PathName name("zstd.dll");
+#else
+	Firebird::PathName name("libzstd." SHRLIB_EXT ".1");
+#endif
+	z.reset(ModuleLoader::fixAndLoadModule(status, name));
+	if (z)
+		symbols();
+}
+
+void ZStd::symbols()
+{
+#define FB_ZSYMB(A) z->findSymbol(status, STRINGIZE(A), A); if (!A) { z.reset(NULL); return; }
+	FB_ZSYMB(ZSTD_isError)
+	FB_ZSYMB(ZSTD_createCCtx_advanced)
+	FB_ZSYMB(ZSTD_freeCCtx)
+	FB_ZSYMB(ZSTD_CCtx_setParameter)
+	FB_ZSYMB(ZSTD_compressStream2)
+	FB_ZSYMB(ZSTD_createDCtx_advanced)
+	FB_ZSYMB(ZSTD_freeDCtx)
+	FB_ZSYMB(ZSTD_decompressStream)
+#undef FB_ZSYMB
+}
+
+void* ZStd::allocFunc(void*, size_t size)
+{
+	try
+	{
+		return MemoryPool::globalAlloc(size ALLOC_ARGS);
+	}
+	catch (const Exception&)
+	{
+		return nullptr;
+	}
+}
+
+void ZStd::freeFunc(void*, void* address)
+{
+	MemoryPool::globalFree(address);
+}
+
 #endif // HAVE_ZLIB_H
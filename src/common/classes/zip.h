@@ -1,7 +1,7 @@
 /*
  *	PROGRAM:	Common class definition
  *	MODULE:		zip.h
- *	DESCRIPTION:	ZIP compression library loader.
+ *	DESCRIPTION:	ZIP, LZ4 and Zstandard compression libraries loaders.
  *
  *  The contents of this file are subject to the Initial
  *  Developer's Public License Version 1.0 (the "License");
@@ -59,6 +59,105 @@ namespace Firebird {
 
 		void symbols();
 	};
+
+	// LZ4 frame API is used. Its few types are declared here, so that the library
+	// is required at runtime only.
+	class LZ4
+	{
+	public:
+		typedef struct LZ4F_cctx_s Compressor;
+		typedef struct LZ4F_dctx_s Decompressor;
+
+		static constexpr unsigned VERSION = 100;			// LZ4F_VERSION
+		static constexpr size_t HEADER_SIZE_MAX = 19;		// LZ4F_HEADER_SIZE_MAX
+
+		explicit LZ4(Firebird::MemoryPool&);
+
+		unsigned (*LZ4F_isError)(size_t code);
+		size_t (*LZ4F_createCompressionContext)(Compressor** cctx, unsigned version);
+		size_t (*LZ4F_freeCompressionContext)(Compressor* cctx);
+		size_t (*LZ4F_compressBound)(size_t srcSize, const void* prefs);
+		size_t (*LZ4F_compressBegin)(Compressor* cctx, void* dst, size_t dstCapacity, const void* prefs);
+		size_t (*LZ4F_compressUpdate)(Compressor* cctx, void* dst, size_t dstCapacity,
+			const void* src, size_t srcSize, const void* options);
+		size_t (*LZ4F_flush)(Compressor* cctx, void* dst, size_t dstCapacity, const void* options);
+		size_t (*LZ4F_createDecompressionContext)(Decompressor** dctx, unsigned version);
+		size_t (*LZ4F_freeDecompressionContext)(Decompressor* dctx);
+		size_t (*LZ4F_decompress)(Decompressor* dctx, void* dst, size_t* dstSize,
+			const void* src, size_t* srcSize, const void* options);
+
+		operator bool() { return z.hasData(); }
+		bool operator!() { return !z.hasData(); }
+
+		ISC_STATUS_ARRAY status;
+
+	private:
+		AutoPtr<ModuleLoader::Module> z;
+
+		void symbols();
+	};
+
+	// Zstandard streaming API, declared here for the same reason
+	class ZStd
+	{
+	public:
+		typedef struct ZSTD_CCtx_s Compressor;
+		typedef struct ZSTD_DCtx_s Decompressor;
+
+		struct InBuffer
+		{
+			const void* src;
+			size_t size;
+			size_t pos;
+		};
+
+		struct OutBuffer
+		{
+			void* dst;
+			size_t size;
+			size_t pos;
+		};
+
+		// ZSTD_customMem
+		struct CustomMem
+		{
+			void* (*customAlloc)(void* opaque, size_t size);
+			void (*customFree)(void* opaque, void* address);
+			void* opaque;
+		};
+
+		// ZSTD_EndDirective
+		static constexpr int E_CONTINUE = 0;
+		static constexpr int E_FLUSH = 1;
+
+		// ZSTD_cParameter
+		static constexpr int C_COMPRESSION_LEVEL = 100;
+		static constexpr int C_WINDOW_LOG = 101;
+
+		explicit ZStd(Firebird::MemoryPool&);
+
+		unsigned (*ZSTD_isError)(size_t code);
+		Compressor* (*ZSTD_createCCtx_advanced)(CustomMem customMem);
+		size_t (*ZSTD_freeCCtx)(Compressor* cctx);
+		size_t (*ZSTD_CCtx_setParameter)(Compressor* cctx, int param, int value);
+		size_t (*ZSTD_compressStream2)(Compressor* cctx, OutBuffer* output, InBuffer* input, int endOp);
+		Decompressor* (*ZSTD_createDCtx_advanced)(CustomMem customMem);
+		size_t (*ZSTD_freeDCtx)(Decompressor* dctx);
+		size_t (*ZSTD_decompressStream)(Decompressor* dctx, OutBuffer* output, InBuffer* input);
+
+		operator bool() { return z.hasData(); }
+		bool operator!() { return !z.hasData(); }
+
+		static void* allocFunc(void*, size_t size);
+		static void freeFunc(void*, void* address);
+
+		ISC_STATUS_ARRAY status;
+
+	private:
+		AutoPtr<ModuleLoader::Module> z;
+
+		void symbols();
+	};
 }
 #endif // HAVE_ZLIB_H
 
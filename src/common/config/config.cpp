@@ -421,6 +421,17 @@ void Config::checkValues()
 
 	checkIntForLoBound(KEY_MAX_STATEMENT_CACHE_SIZE, 0, true);
 
+	checkIntForLoBound(KEY_INLINE_BLOB_THRESHOLD, 0, true);
+
+	checkIntForLoBound(KEY_BULK_INDEX_BUFFER, 0, true);
+	checkIntForLoBound(KEY_SHARED_STATEMENT_CACHE_SIZE, 0, true);
+
+	checkIntForLoBound(KEY_REMOTE_FETCH_AHEAD, 1, false);
+	checkIntForHiBound(KEY_REMOTE_FETCH_AHEAD, 16, false);
+
+	checkIntForLoBound(KEY_BATCH_RUN_SIZE, 0, true);
+	checkIntForHiBound(KEY_BATCH_RUN_SIZE, 65536, false);
+
 	checkIntForLoBound(KEY_MAX_PARALLEL_WORKERS, 1, true);
 	checkIntForHiBound(KEY_MAX_PARALLEL_WORKERS, 64, false);	// todo: detect number of available cores
 
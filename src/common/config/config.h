@@ -187,6 +187,15 @@ enum ConfigKey
 	KEY_PARALLEL_WORKERS,
 	KEY_MAX_PARALLEL_WORKERS,
 	KEY_OPTIMIZE_FOR_FIRST_ROWS,
+	KEY_CACHE_PREWARM,
+	KEY_LZ_RECORD_COMPRESSION,
+	KEY_LZ_BLOB_COMPRESSION,
+	KEY_INLINE_BLOB_THRESHOLD,
+	KEY_BULK_INDEX_BUFFER,
+	KEY_SHARED_STATEMENT_CACHE_SIZE,
+	KEY_WIRE_COMPRESSION_METHODS,
+	KEY_REMOTE_FETCH_AHEAD,
+	KEY_BATCH_RUN_SIZE,
 	MAX_CONFIG_KEY		// keep it last
 };
 
@@ -300,7 +309,16 @@ constexpr ConfigEntry entries[MAX_CONFIG_KEY] =
 	{TYPE_INTEGER,	"MaxStatementCacheSize",	false,	2 * 1048576},	// bytes
 	{TYPE_INTEGER,	"ParallelWorkers",			true,	1},
 	{TYPE_INTEGER,	"MaxParallelWorkers",		true,	1},
-	{TYPE_BOOLEAN,	"OptimizeForFirstRows",		false,	false}
+	{TYPE_BOOLEAN,	"OptimizeForFirstRows",		false,	false},
+	{TYPE_BOOLEAN,	"CachePrewarm",				false,	false},
+	{TYPE_BOOLEAN,	"LZRecordCompression",		false,	false},
+	{TYPE_BOOLEAN,	"LZBlobCompression",		false,	false},
+	{TYPE_INTEGER,	"InlineBlobThreshold",		false,	0},		// bytes
+	{TYPE_INTEGER,	"BulkIndexBuffer",			false,	0},		// bytes
+	{TYPE_INTEGER,	"SharedStatementCacheSize",	false,	0},				// bytes
+	{TYPE_STRING,	"WireCompressionMethods",	false,	"zstd, lz4, zlib"},
+	{TYPE_INTEGER,	"RemoteFetchAhead",			false,	1},		// batches
+	{TYPE_INTEGER,	"BatchRunSize",				false,	0}		// messages
 };
 
 
@@ -624,6 +642,24 @@ public:
 	CONFIG_GET_GLOBAL_INT(getMaxParallelWorkers, KEY_MAX_PARALLEL_WORKERS);
 
 	CONFIG_GET_PER_DB_BOOL(getOptimizeForFirstRows, KEY_OPTIMIZE_FOR_FIRST_ROWS);
+
+	CONFIG_GET_PER_DB_BOOL(getCachePrewarm, KEY_CACHE_PREWARM);
+
+	CONFIG_GET_PER_DB_BOOL(getLZRecordCompression, KEY_LZ_RECORD_COMPRESSION);
+
+	CONFIG_GET_PER_DB_BOOL(getLZBlobCompression, KEY_LZ_BLOB_COMPRESSION);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getInlineBlobThreshold, KEY_INLINE_BLOB_THRESHOLD, getInt);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getBulkIndexBuffer, KEY_BULK_INDEX_BUFFER, getInt);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getSharedStatementCacheSize, KEY_SHARED_STATEMENT_CACHE_SIZE, getInt);
+
+	CONFIG_GET_PER_DB_STR(getWireCompressionMethods, KEY_WIRE_COMPRESSION_METHODS);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getRemoteFetchAhead, KEY_REMOTE_FETCH_AHEAD, getInt);
+
+	CONFIG_GET_PER_DB_KEY(ULONG, getBatchRunSize, KEY_BATCH_RUN_SIZE, getInt);
 };
 
 // Implementation of interface to access master configuration file
@@ -360,8 +360,14 @@ namespace os_utils
 
 #ifdef WIN_NT
 	void setDefaultAffinity();
+#else
+	// restrict process to the given set of CPUs, as CpuAffinityMask does on Windows
+	void setAffinity(FB_UINT64 mask);
 #endif
 
+	// NUMA node of the CPU running current thread, 0 if unknown
+	unsigned getCurrentNumaNode();
+
 	class CtrlCHandler
 	{
 	public:
@@ -33,6 +33,7 @@
 #include "../common/os/os_utils.h"
 #include "../common/os/isc_i_proto.h"
 #include "../jrd/constants.h"
+#include "../yvalve/gds_proto.h"
 
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -92,6 +93,11 @@
 
 #include <stdio.h>
 
+#ifdef LINUX
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
 using namespace Firebird;
 
 namespace os_utils
@@ -434,6 +440,34 @@ void getUniqueFileId(const char* name, UCharBuffer& id)
 	makeUniqueFileId(statistics, id);
 }
 
+void setAffinity(FB_UINT64 mask)
+{
+#ifdef LINUX
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+
+	for (unsigned cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++)
+	{
+		if (mask & (FB_CONST64(1) << cpu))
+			CPU_SET(cpu, &cpuSet);
+	}
+
+	if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+		gds__log("sched_setaffinity() failed, errno=%d", errno);
+#endif
+}
+
+unsigned getCurrentNumaNode()
+{
+#if defined(LINUX) && defined(SYS_getcpu)
+	unsigned cpu, node;
+	if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+		return node;
+#endif
+
+	return 0;
+}
+
 /// class CtrlCHandler
 
 bool CtrlCHandler::terminated = false;
@@ -620,6 +620,18 @@ void setDefaultAffinity()
 		SetProcessAffinityMask(hCurrProc, newMask);
 }
 
+unsigned getCurrentNumaNode()
+{
+	PROCESSOR_NUMBER procNumber;
+	GetCurrentProcessorNumberEx(&procNumber);
+
+	USHORT node;
+	if (!GetNumaProcessorNodeEx(&procNumber, &node) || node == MAXUSHORT)
+		return 0;
+
+	return node;
+}
+
 
 /// class CtrlCHandler
 
@@ -1101,6 +1101,16 @@ void CountAggNode::aggPass(thread_db* /*tdbb*/, Request* request, dsc* /*desc*/)
 		++impure->vlu_misc.vlu_int64;
 }
 
+void CountAggNode::aggPassCount(Request* request, SINT64 count) const
+{
+	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
+
+	if (dialect1)
+		impure->vlu_misc.vlu_long += (SLONG) count;
+	else
+		impure->vlu_misc.vlu_int64 += count;
+}
+
 dsc* CountAggNode::aggExecute(thread_db* /*tdbb*/, Request* request) const
 {
 	impure_value_ex* impure = request->getImpure<impure_value_ex>(impureOffset);
@@ -151,6 +151,9 @@ public:
 	virtual void aggPass(thread_db* tdbb, Request* request, dsc* desc) const;
 	virtual dsc* aggExecute(thread_db* tdbb, Request* request) const;
 
+	// Account the given number of records at once
+	void aggPassCount(Request* request, SINT64 count) const;
+
 protected:
 	virtual AggNode* dsqlCopy(DsqlCompilerScratch* dsqlScratch) /*const*/;
 };
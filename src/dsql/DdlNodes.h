@@ -1702,7 +1702,8 @@ public:
 	struct Definition
 	{
 		Definition()
-			: type(0)
+			: type(0),
+			  blockRange(false)
 		{
 			expressionBlr.clear();
 			expressionSource.clear();
@@ -1716,6 +1717,7 @@ public:
 		Firebird::TriState descending;
 		Firebird::TriState inactive;
 		SSHORT type;
+		bool blockRange;
 		bid expressionBlr;
 		bid expressionSource;
 		bid conditionBlr;
@@ -1750,6 +1752,7 @@ public:
 	MetaName name;
 	bool unique = false;
 	bool descending = false;
+	bool blockRange = false;
 	bool active = true;
 	NestConst<RelationSourceNode> relation;
 	NestConst<ValueListNode> columns;
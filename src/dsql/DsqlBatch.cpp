@@ -58,6 +58,93 @@ namespace {
 	private:
 		thread_db* m_tdbb;
 	};
+
+	ULONG changedRecords(const Request* req)
+	{
+		return req->req_records_inserted + req->req_records_updated + req->req_records_deleted;
+	}
+
+	// Passes the messages following the current one to the request executing
+	// in batch mode, so that they are processed by the same looper run
+
+	class MessageRun : public BatchMessageSource
+	{
+	public:
+		MessageRun(MemoryPool& pool, const Request* req, ULONG messageSize, ULONG alignment)
+			: m_request(req),
+			  m_messageSize(messageSize),
+			  m_alignment(alignment),
+			  m_counts(pool)
+		{ }
+
+		void start(UCHAR* data, ULONG remains, ULONG limit)
+		{
+			m_next = data;
+			m_remains = remains;
+			m_limit = limit;
+			m_counts.clear();
+			m_before = changedRecords(m_request);
+		}
+
+		bool getMessage(thread_db* /*tdbb*/, UCHAR* buffer, ULONG length) override
+		{
+			if (m_counts.getCount() + 1 >= m_limit || length != m_messageSize)
+				return false;
+
+			UCHAR* const alignedData = FB_ALIGN(m_next, m_alignment);
+			const ULONG skip = alignedData - m_next;
+
+			if (m_remains < skip + m_messageSize)
+				return false;
+
+			finishMessage();
+
+			memcpy(buffer, alignedData, m_messageSize);
+			m_next = alignedData + m_messageSize;
+			m_remains -= skip + m_messageSize;
+
+			return true;
+		}
+
+		void finishMessage()
+		{
+			const ULONG after = changedRecords(m_request);
+			m_counts.add(after - m_before);
+			m_before = after;
+		}
+
+		// Messages taken from the batch, including the first one
+		ULONG getCount() const
+		{
+			return m_counts.getCount() + 1;
+		}
+
+		UCHAR* getNext() const
+		{
+			return m_next;
+		}
+
+		ULONG getRemains() const
+		{
+			return m_remains;
+		}
+
+		// Records changed by every message of the finished run
+		const HalfStaticArray<ULONG, 64>& getCounts() const
+		{
+			return m_counts;
+		}
+
+	private:
+		const Request* const m_request;
+		const ULONG m_messageSize;
+		const ULONG m_alignment;
+		HalfStaticArray<ULONG, 64> m_counts;
+		UCHAR* m_next = nullptr;
+		ULONG m_remains = 0;
+		ULONG m_limit = 0;
+		ULONG m_before = 0;
+	};
 }
 
 DsqlBatch::DsqlBatch(DsqlDmlRequest* req, const dsql_msg* /*message*/, IMessageMetadata* inMeta, ClumpletReader& pb)
@@ -671,11 +758,19 @@ private:
 	bool isExecBlock = dStmt->getType() == DsqlStatement::TYPE_EXEC_BLOCK;
 	const dsql_msg* receiveMessage = isExecBlock ? dStmt->getReceiveMsg() : nullptr;
 
+	// Messages without blobs may be executed by runs of the request, see BatchRunSize
+	const ULONG runSize = (isExecBlock || m_blobMeta.hasData()) ? 0 :
+		tdbb->getDatabase()->dbb_config->getBatchRunSize();
+	MessageRun run(*tdbb->getDefaultPool(), req, m_messageSize, m_alignment);
+
 	// process messages
 	ULONG remains;
 	UCHAR* data;
 	while ((remains = m_messages.get(&data)) > 0)
 	{
+		// Messages of the failed run are executed one by one up to this point
+		const UCHAR* replayEnd = nullptr;
+
 		if (remains < m_messageSize)
 		{
 			ERRD_post(Arg::Gds(isc_sqlerr) << Arg::Num(-104) <<
@@ -725,14 +820,32 @@ private:
 				*id = newId;
 			}
 
+			const bool useRun = (runSize > 1 && (!replayEnd || data >= replayEnd));
+
 			try
 			{
+				if (useRun)
+				{
+					// send this and the following messages to request in a single run
+					run.start(data + m_messageSize, remains - m_messageSize, runSize);
+					{
+						AutoSetRestore<BatchMessageSource*> source(&req->req_batch_source, &run);
+						EXE_send(tdbb, req, sendMessage->msg_number, m_messageSize, data);
+					}
+					run.finishMessage();
+
+					for (const auto count : run.getCounts())
+						completionState->regUpdate(count);
+
+					data = run.getNext();
+					remains = run.getRemains();
+					continue;
+				}
+
 				// runsend data to request and collect stats
-				ULONG before = req->req_records_inserted + req->req_records_updated +
-					req->req_records_deleted;
+				ULONG before = changedRecords(req);
 				EXE_send(tdbb, req, sendMessage->msg_number, m_messageSize, data);
-				ULONG after = req->req_records_inserted + req->req_records_updated +
-					req->req_records_deleted;
+				ULONG after = changedRecords(req);
 				completionState->regUpdate(after - before);
 
 				if (receiveMessage)
@@ -744,6 +857,16 @@ private:
 				ex.stuffException(&status);
 				tdbb->tdbb_status_vector->init();
 
+				// The failed run is undone by the request's savepoint. Execute its messages
+				// again one by one to report the error for the message which caused it.
+				// Cancellation is not caused by a message, so report it for the first one.
+				if (useRun && run.getCount() > 1 && status->getErrors()[1] != isc_cancelled)
+				{
+					replayEnd = run.getNext();
+					startRequest = true;
+					continue;
+				}
+
 				JTransliterate trLit(tdbb);
 				completionState->regError(&status, &trLit);
 
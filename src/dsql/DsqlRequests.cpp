@@ -245,6 +245,15 @@ DsqlDmlRequest::DsqlDmlRequest(thread_db* tdbb, MemoryPool& pool, dsql_dbb* dbb,
 	request = aStatement->getStatement()->findRequest(tdbb);
 	tdbb->getAttachment()->att_requests.add(request);
 
+	// Positioned updates need the physical record versions,
+	// so the cursor records must not be restored from index keys
+
+	if (aStatement->getType() == DsqlStatement::TYPE_SELECT_UPD)
+	{
+		for (auto& rpb : request->req_rpb)
+			rpb.rpb_stream_flags |= RPB_s_keyed;
+	}
+
 	// If this is positional DML - subscribe to parent cursor as well
 
 	if (aStatement->parentCursorName.hasData())
@@ -23,6 +23,7 @@
 #include "firebird.h"
 #include "../dsql/DsqlStatementCache.h"
 #include "../dsql/DsqlStatements.h"
+#include "../dsql/dsql.h"
 #include "../jrd/Attachment.h"
 #include "../jrd/Statement.h"
 #include "../jrd/lck.h"
@@ -63,6 +64,10 @@ int DsqlStatementCache::blockingAst(void* astObject)
 		AsyncContextHolder tdbb(dbb, FB_FUNCTION, self->lock);
 
 		self->purge(tdbb, false);
+
+		// Metadata was changed, the statements prepared by other attachments are stale too
+		if (dbb->dbb_shared_statements)
+			dbb->dbb_shared_statements->purge();
 	}
 	catch (const Exception&)
 	{} // no-op
@@ -74,7 +79,7 @@ RefPtr<DsqlStatement> DsqlStatementCache::getStatement(thread_db* tdbb, const st
 	bool isInternalRequest)
 {
 	RefStrPtr key;
-	buildStatementKey(tdbb, key, text, clientDialect, isInternalRequest);
+	buildStatementKey(tdbb, getPool(), key, text, clientDialect, isInternalRequest);
 
 	if (const auto entryPtr = map.get(key))
 	{
@@ -132,7 +137,7 @@ void DsqlStatementCache::putStatement(thread_db* tdbb, const string& text, USHOR
 	const unsigned statementSize = dsqlStatement->getSize();
 
 	RefStrPtr key;
-	buildStatementKey(tdbb, key, text, clientDialect, isInternalRequest);
+	buildStatementKey(tdbb, getPool(), key, text, clientDialect, isInternalRequest);
 
 	StatementEntry newStatement(getPool());
 	newStatement.key = key;
@@ -244,6 +249,9 @@ void DsqlStatementCache::purgeAllAttachments(thread_db* tdbb)
 {
 	purge(tdbb, false);
 
+	if (const auto sharedCache = tdbb->getDatabase()->dbb_shared_statements)
+		sharedCache->purge();
+
 	fb_assert(!lock || lock->lck_logical == LCK_SR);
 
 	Lock tempLock(tdbb, 0, LCK_dsql_statement_cache);
@@ -254,15 +262,15 @@ void DsqlStatementCache::purgeAllAttachments(thread_db* tdbb)
 	LCK_release(tdbb, &tempLock);
 }
 
-void DsqlStatementCache::buildStatementKey(thread_db* tdbb, RefStrPtr& key, const string& text, USHORT clientDialect,
-	bool isInternalRequest)
+void DsqlStatementCache::buildStatementKey(thread_db* tdbb, MemoryPool& pool, RefStrPtr& key, const string& text,
+	USHORT clientDialect, bool isInternalRequest)
 {
 	const auto attachment = tdbb->getAttachment();
 
 	const SSHORT charSetId = isInternalRequest ? CS_METADATA : attachment->att_charset;
 	const int debugOptions = (int) attachment->getDebugOptions().getDsqlKeepBlr();
 
-	key = FB_NEW_POOL(getPool()) RefString(getPool());
+	key = FB_NEW_POOL(pool) RefString(pool);
 
 	key->resize(1 + sizeof(charSetId) + text.length());
 	char* p = key->begin();
@@ -338,3 +346,199 @@ void DsqlStatementCache::dump()
 	printf("\n");
 }
 #endif
+
+
+// Class DsqlSharedStatementCache::Image
+
+DsqlSharedStatementCache::Image::Image(MemoryPool& p, const DsqlDmlStatement* statement,
+		const UCHAR* aBlr, ULONG blrLength, const UCHAR* aDebugData, ULONG debugDataLength,
+		bool aInternalRequest)
+	: PermanentStorage(p),
+	  sqlText(p),
+	  parentCursorName(p, statement->parentCursorName),
+	  blr(p),
+	  debugData(p),
+	  sendMsg(p),
+	  receiveMsg(p),
+	  flags(statement->getFlags()),
+	  blrVersion(statement->getBlrVersion()),
+	  type(statement->getType()),
+	  internalRequest(aInternalRequest)
+{
+	if (statement->getSqlText())
+		sqlText = *statement->getSqlText();
+
+	blr.assign(aBlr, blrLength);
+	debugData.assign(aDebugData, debugDataLength);
+
+	storeMessage(sendMsg, statement->getSendMsg());
+	storeMessage(receiveMsg, statement->getReceiveMsg());
+}
+
+void DsqlSharedStatementCache::Image::storeMessage(Message& to, const dsql_msg* from)
+{
+	if (!from)
+		return;
+
+	to.present = true;
+	to.number = from->msg_number;
+	to.length = from->msg_length;
+	to.parameter = from->msg_parameter;
+	to.index = from->msg_index;
+
+	for (const auto par : from->msg_parameters)
+	{
+		auto& parameter = to.parameters.add();
+		parameter.name = par->par_name;
+		parameter.relName = par->par_rel_name;
+		parameter.ownerName = par->par_owner_name;
+		parameter.relAlias = par->par_rel_alias;
+		parameter.alias = par->par_alias;
+		parameter.desc = par->par_desc;
+		parameter.parameter = par->par_parameter;
+		parameter.index = par->par_index;
+		parameter.isText = par->par_is_text;
+
+		FB_SIZE_T pos;
+		if (par->par_null && from->msg_parameters.find(par->par_null, pos))
+			parameter.nullParameter = (int) pos;
+	}
+}
+
+// Recreate a message in the pool of a statement.
+dsql_msg* DsqlSharedStatementCache::Image::makeMessage(MemoryPool& pool, const Message& message) const
+{
+	if (!message.present)
+		return nullptr;
+
+	const auto msg = FB_NEW_POOL(pool) dsql_msg(pool);
+	msg->msg_number = message.number;
+	msg->msg_length = message.length;
+	msg->msg_parameter = message.parameter;
+	msg->msg_index = message.index;
+
+	for (const auto& parameter : message.parameters)
+	{
+		const auto par = FB_NEW_POOL(pool) dsql_par(pool);
+		par->par_message = msg;
+		par->par_name = parameter.name;
+		par->par_rel_name = parameter.relName;
+		par->par_owner_name = parameter.ownerName;
+		par->par_rel_alias = parameter.relAlias;
+		par->par_alias = parameter.alias;
+		par->par_desc = parameter.desc;
+		par->par_parameter = parameter.parameter;
+		par->par_index = parameter.index;
+		par->par_is_text = parameter.isText;
+
+		msg->msg_parameters.add(par);
+	}
+
+	for (FB_SIZE_T i = 0; i < message.parameters.getCount(); ++i)
+	{
+		const int nullParameter = message.parameters[i].nullParameter;
+
+		if (nullParameter >= 0)
+			msg->msg_parameters[i]->par_null = msg->msg_parameters[nullParameter];
+	}
+
+	return msg;
+}
+
+unsigned DsqlSharedStatementCache::Image::getSize() const
+{
+	return (unsigned) (sizeof(Image) + sqlText.length() + blr.getCount() + debugData.getCount() +
+		(sendMsg.parameters.getCount() + receiveMsg.parameters.getCount()) * sizeof(Parameter));
+}
+
+
+// Class DsqlSharedStatementCache
+
+DsqlSharedStatementCache::DsqlSharedStatementCache(MemoryPool& o, Database* dbb)
+	: PermanentStorage(o),
+	  map(o),
+	  imageList(o)
+{
+	// Only a shared Database object is seen by all attachments
+	if (dbb->dbb_flags & DBB_shared)
+		maxCacheSize = dbb->dbb_config->getSharedStatementCacheSize();
+}
+
+RefPtr<DsqlSharedStatementCache::Image> DsqlSharedStatementCache::getImage(thread_db* tdbb, const string& text,
+	USHORT clientDialect, bool isInternalRequest)
+{
+	RefStrPtr key;
+	buildImageKey(tdbb, key, text, clientDialect, isInternalRequest);
+
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	if (const auto entryPtr = map.get(key))
+	{
+		const auto entry = *entryPtr;
+		imageList.splice(imageList.end(), imageList, entry);
+
+		return entry->image;
+	}
+
+	return {};
+}
+
+void DsqlSharedStatementCache::putImage(thread_db* tdbb, const string& text, USHORT clientDialect,
+	bool isInternalRequest, ULONG imageGeneration, Image* image)
+{
+	RefStrPtr key;
+	buildImageKey(tdbb, key, text, clientDialect, isInternalRequest);
+
+	const unsigned imageSize = image->getSize();
+
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	// Metadata might be changed while the statement was prepared
+	if (imageGeneration != generation || map.exist(key) || imageSize > maxCacheSize)
+		return;
+
+	ImageEntry newImage;
+	newImage.key = key;
+	newImage.image = image;
+	newImage.size = imageSize;
+
+	imageList.pushBack(std::move(newImage));
+	map.put(key, --imageList.end());
+
+	cacheSize += imageSize;
+
+	if (cacheSize > maxCacheSize)
+		shrink();
+}
+
+void DsqlSharedStatementCache::purge()
+{
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
+	++generation;
+
+	map.clear();
+	imageList.clear();
+	cacheSize = 0;
+}
+
+void DsqlSharedStatementCache::buildImageKey(thread_db* tdbb, RefStrPtr& key, const string& text,
+	USHORT clientDialect, bool isInternalRequest)
+{
+	DsqlStatementCache::buildStatementKey(tdbb, getPool(), key, text, clientDialect, isInternalRequest);
+
+	// Typed date/time literals are converted by DSQL using the session time zone
+	const USHORT timeZone = tdbb->getAttachment()->att_current_timezone;
+	key->append((const char*) &timeZone, sizeof(timeZone));
+}
+
+void DsqlSharedStatementCache::shrink()
+{
+	while (cacheSize > maxCacheSize && !imageList.isEmpty())
+	{
+		const auto& front = imageList.front();
+		map.remove(front.key);
+		cacheSize -= front.size;
+		imageList.erase(imageList.begin());
+	}
+}
@@ -26,18 +26,26 @@
 ///#define DSQL_STATEMENT_CACHE_DEBUG 1
 
 #include "../common/classes/alloc.h"
+#include "../common/classes/array.h"
 #include "../common/classes/DoublyLinkedList.h"
 #include "../common/classes/fb_string.h"
 #include "../common/classes/GenericMap.h"
+#include "../common/classes/locks.h"
 #include "../common/classes/objects_array.h"
 #include "../common/classes/RefCounted.h"
+#include "../common/dsc.h"
+#include "../jrd/MetaName.h"
+#include <atomic>
 
 namespace Jrd {
 
 
 class Attachment;
+class Database;
+class DsqlDmlStatement;
 class DsqlStatement;
 class Lock;
+class dsql_msg;
 class thread_db;
 
 
@@ -112,15 +120,15 @@ public:
 	void purge(thread_db* tdbb, bool releaseLock);
 	void purgeAllAttachments(thread_db* tdbb);
 
+	static void buildStatementKey(thread_db* tdbb, MemoryPool& pool, Firebird::RefStrPtr& key,
+		const Firebird::string& text, USHORT clientDialect, bool isInternalRequest);
+
 	void shutdown(thread_db* tdbb)
 	{
 		purge(tdbb, true);
 	}
 
 private:
-	void buildStatementKey(thread_db* tdbb, Firebird::RefStrPtr& key, const Firebird::string& text,
-		USHORT clientDialect, bool isInternalRequest);
-
 	void buildVerifyKey(thread_db* tdbb, Firebird::string& key, bool isInternalRequest);
 	void shrink();
 	void ensureLockIsCreated(thread_db* tdbb);
@@ -143,6 +151,138 @@ private:
 };
 
 
+// Database-wide cache of DML statements prepared by DSQL, used by SuperServer.
+// Compiled statement trees refer to the metadata cache of their attachment and
+// cannot be shared, so the cache keeps what DSQL produces for them: BLR, messages
+// and statement attributes. An attachment finding the statement there skips the
+// parser and the DSQL pass, and only compiles the BLR into its own tree.
+class DsqlSharedStatementCache final : public Firebird::PermanentStorage
+{
+public:
+	class Image final : public Firebird::RefCounted, public Firebird::PermanentStorage
+	{
+	public:
+		struct Parameter
+		{
+			explicit Parameter(MemoryPool& p)
+				: name(p),
+				  relName(p),
+				  ownerName(p),
+				  relAlias(p),
+				  alias(p)
+			{
+			}
+
+			MetaName name;
+			MetaName relName;
+			MetaName ownerName;
+			MetaName relAlias;
+			MetaName alias;
+			dsc desc;
+			USHORT parameter = 0;
+			USHORT index = 0;
+			int nullParameter = -1;		// position of null indicator parameter in the message
+			bool isText = false;
+		};
+
+		struct Message
+		{
+			explicit Message(MemoryPool& p)
+				: parameters(p)
+			{
+			}
+
+			Firebird::ObjectsArray<Parameter> parameters;
+			USHORT number = 0;
+			ULONG length = 0;
+			USHORT parameter = 0;
+			USHORT index = 0;
+			bool present = false;
+		};
+
+		Image(MemoryPool& p, const DsqlDmlStatement* statement, const UCHAR* aBlr, ULONG blrLength,
+			const UCHAR* aDebugData, ULONG debugDataLength, bool aInternalRequest);
+
+		dsql_msg* makeMessage(MemoryPool& pool, const Message& message) const;
+
+		unsigned getSize() const;
+
+	private:
+		static void storeMessage(Message& to, const dsql_msg* from);
+
+	public:
+		Firebird::string sqlText;
+		MetaName parentCursorName;
+		Firebird::UCharBuffer blr;
+		Firebird::UCharBuffer debugData;
+		Message sendMsg;
+		Message receiveMsg;
+		ULONG flags;
+		unsigned blrVersion;
+		USHORT type;
+		bool internalRequest;
+	};
+
+	DsqlSharedStatementCache(MemoryPool& o, Database* dbb);
+
+	DsqlSharedStatementCache(const DsqlSharedStatementCache&) = delete;
+	DsqlSharedStatementCache& operator=(const DsqlSharedStatementCache&) = delete;
+
+	bool isActive() const
+	{
+		return maxCacheSize > 0;
+	}
+
+	// Changes on every purge, an image prepared across a purge is not cached
+	ULONG getGeneration() const
+	{
+		return generation;
+	}
+
+	Firebird::RefPtr<Image> getImage(thread_db* tdbb, const Firebird::string& text,
+		USHORT clientDialect, bool isInternalRequest);
+
+	void putImage(thread_db* tdbb, const Firebird::string& text, USHORT clientDialect,
+		bool isInternalRequest, ULONG imageGeneration, Image* image);
+
+	void purge();
+
+private:
+	struct ImageEntry
+	{
+		Firebird::RefStrPtr key;
+		Firebird::RefPtr<Image> image;
+		unsigned size = 0;
+	};
+
+	class RefStrPtrComparator
+	{
+	public:
+		static bool greaterThan(const Firebird::RefStrPtr& i1, const Firebird::RefStrPtr& i2)
+		{
+			return *i1 > *i2;
+		}
+	};
+
+	void buildImageKey(thread_db* tdbb, Firebird::RefStrPtr& key, const Firebird::string& text,
+		USHORT clientDialect, bool isInternalRequest);
+
+	void shrink();
+
+private:
+	Firebird::Mutex mutex;
+	Firebird::NonPooledMap<
+		Firebird::RefStrPtr,
+		Firebird::DoublyLinkedList<ImageEntry>::Iterator,
+		RefStrPtrComparator
+	> map;
+	Firebird::DoublyLinkedList<ImageEntry> imageList;	// least recently used first
+	std::atomic<ULONG> generation{0};
+	unsigned maxCacheSize = 0;
+	unsigned cacheSize = 0;
+};
+
+
 }	// namespace Jrd
 
 #endif // DSQL_STATEMENT_CACHE_H
@@ -117,6 +117,9 @@ void DsqlDmlStatement::doRelease()
 		{} // no-op
 	}
 
+	// The pool is deleted without calling the destructor
+	sharedImage = nullptr;
+
 	DsqlStatement::doRelease();
 }
 
@@ -156,6 +159,57 @@ void DsqlDmlStatement::dsqlPass(thread_db* tdbb, DsqlCompilerScratch* scratch, n
 	}
 #endif
 
+	const auto& blr = scratch->getBlrData();
+	const auto& debugData = scratch->getDebugData();
+	const bool internalFlag = (scratch->flags & DsqlCompilerScratch::FLAG_INTERNAL_REQUEST);
+
+	const ISC_STATUS status = compile(tdbb, blr.begin(), blr.getCount(),
+		debugData.begin(), debugData.getCount(), internalFlag, traceResult);
+
+	// Save the DSQL output for other attachments preparing the same text
+	if (!status && (scratch->flags & DsqlCompilerScratch::FLAG_SHARED_IMAGE))
+	{
+		const auto dbb = tdbb->getDatabase();
+		sharedImage = FB_NEW_POOL(*dbb->dbb_permanent)
+			DsqlSharedStatementCache::Image(*dbb->dbb_permanent, this, blr.begin(), blr.getCount(),
+				debugData.begin(), debugData.getCount(), internalFlag);
+	}
+
+	// free blr memory
+	scratch->getBlrData().free();
+
+	if (status)
+		status_exception::raise(tdbb->tdbb_status_vector);
+
+	node = nullptr;
+	scratch = nullptr;
+}
+
+// Make the statement from an image prepared by another attachment, only the JRD compilation is done.
+void DsqlDmlStatement::loadSharedImage(thread_db* tdbb, DsqlSharedStatementCache::Image* image,
+	ntrace_result_t* traceResult)
+{
+	auto& pool = getPool();
+
+	setSqlText(FB_NEW_POOL(pool) RefString(pool, image->sqlText));
+	setSendMsg(image->makeMessage(pool, image->sendMsg));
+	setReceiveMsg(image->makeMessage(pool, image->receiveMsg));
+	setType((Type) image->type);
+	setFlags(image->flags);
+	setBlrVersion(image->blrVersion);
+	parentCursorName = image->parentCursorName;
+
+	const ISC_STATUS status = compile(tdbb, image->blr.begin(), image->blr.getCount(),
+		image->debugData.begin(), image->debugData.getCount(), image->internalRequest, traceResult);
+
+	if (status)
+		status_exception::raise(tdbb->tdbb_status_vector);
+}
+
+// Have the access method compile the statement.
+ISC_STATUS DsqlDmlStatement::compile(thread_db* tdbb, const UCHAR* blr, ULONG blrLength,
+	const UCHAR* debugData, ULONG debugDataLength, bool internalFlag, ntrace_result_t* traceResult)
+{
 	FbLocalStatus localStatus;
 
 	// check for warnings
@@ -170,13 +224,9 @@ void DsqlDmlStatement::dsqlPass(thread_db* tdbb, DsqlCompilerScratch* scratch, n
 
 	try
 	{
-		const auto attachment = scratch->getAttachment()->dbb_attachment;
-		const auto& blr = scratch->getBlrData();
-		const auto& debugData = scratch->getDebugData();
+		const auto attachment = dsqlAttachment->dbb_attachment;
 
-		statement = CMP_compile(tdbb, blr.begin(), blr.getCount(),
-			(scratch->flags & DsqlCompilerScratch::FLAG_INTERNAL_REQUEST),
-			debugData.getCount(), debugData.begin());
+		statement = CMP_compile(tdbb, blr, blrLength, internalFlag, debugDataLength, debugData);
 
 		if (getSqlText())
 			statement->sqlText = getSqlText();
@@ -184,7 +234,7 @@ void DsqlDmlStatement::dsqlPass(thread_db* tdbb, DsqlCompilerScratch* scratch, n
 		fb_assert(statement->blr.isEmpty());
 
 		if (attachment->getDebugOptions().getDsqlKeepBlr())
-			statement->blr.insert(0, blr.begin(), blr.getCount());
+			statement->blr.insert(0, blr, blrLength);
 	}
 	catch (const Exception&)
 	{
@@ -203,14 +253,7 @@ void DsqlDmlStatement::dsqlPass(thread_db* tdbb, DsqlCompilerScratch* scratch, n
 		tdbb->tdbb_status_vector->setWarnings2(saved.length(), saved.value());
 	}
 
-	// free blr memory
-	scratch->getBlrData().free();
-
-	if (status)
-		status_exception::raise(tdbb->tdbb_status_vector);
-
-	node = nullptr;
-	scratch = nullptr;
+	return status;
 }
 
 DsqlDmlRequest* DsqlDmlStatement::createRequest(thread_db* tdbb, dsql_dbb* dbb)
@@ -30,6 +30,7 @@
 #include "../jrd/jrd.h"
 #include "../jrd/ntrace.h"
 #include "../dsql/DsqlRequests.h"
+#include "../dsql/DsqlStatementCache.h"
 
 namespace Jrd {
 
@@ -212,12 +213,24 @@ public:
 	void dsqlPass(thread_db* tdbb, DsqlCompilerScratch* scratch, ntrace_result_t* traceResult) override;
 	DsqlDmlRequest* createRequest(thread_db* tdbb, dsql_dbb* dbb) override;
 
+	void loadSharedImage(thread_db* tdbb, DsqlSharedStatementCache::Image* image, ntrace_result_t* traceResult);
+
+	Firebird::RefPtr<DsqlSharedStatementCache::Image> takeSharedImage()
+	{
+		return std::move(sharedImage);
+	}
+
 protected:
 	void doRelease() override;
 
+private:
+	ISC_STATUS compile(thread_db* tdbb, const UCHAR* blr, ULONG blrLength, const UCHAR* debugData,
+		ULONG debugDataLength, bool internalFlag, ntrace_result_t* traceResult);
+
 private:
 	NestConst<StmtNode> node;
 	Statement* statement = nullptr;
+	Firebird::RefPtr<DsqlSharedStatementCache::Image> sharedImage;	// to be put in the shared cache
 };
 
 
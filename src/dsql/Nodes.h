@@ -1494,6 +1494,7 @@ public:
 	static const unsigned MARK_FOR_UPDATE		= 0x04;	// implicit cursor used in UPDATE\DELETE\MERGE statement
 	static const unsigned MARK_AVOID_COUNTERS	= 0x08;	// do not touch record counters
 	static const unsigned MARK_BULK_INSERT		= 0x10; // StoreNode is used for bulk operation
+	static const unsigned MARK_BULK_INDEX		= 0x20;	// StoreNode may defer keys of non-unique indices
 
 	struct ExeState
 	{
@@ -7256,6 +7256,9 @@ void MergeNode::genBlr(DsqlCompilerScratch* dsqlScratch)
 		if (notMatched->overrideClause.has_value())
 			dsqlScratch->appendUChar(UCHAR(notMatched->overrideClause.value()));
 
+		if (!returning && !dsqlScratch->isPsql())
+			dsqlScratch->putBlrMarkers(MARK_BULK_INDEX);
+
 		GEN_expr(dsqlScratch, notMatched->storeRelation);
 
 		dsqlScratch->appendUChar(blr_begin);
@@ -8561,13 +8564,23 @@ ReceiveNode* ReceiveNode::pass2(thread_db* tdbb, CompilerScratch* csb)
 // Execute a RECEIVE statement. This can be entered either with "req_evaluate" (ordinary receive
 // statement) or "req_proceed" (select statement).
 // In the latter case, the statement isn't every formalled evaluated.
-const StmtNode* ReceiveNode::execute(thread_db* /*tdbb*/, Request* request, ExeState* /*exeState*/) const
+const StmtNode* ReceiveNode::execute(thread_db* tdbb, Request* request, ExeState* /*exeState*/) const
 {
 	switch (request->req_operation)
 	{
 		case Request::req_return:
 			if (!(request->req_batch_mode && batchFlag))
 				break;
+
+			// Take the next message of the batch, if any, and process it right now
+
+			if (request->req_batch_source &&
+				request->req_batch_source->getMessage(tdbb, message->getBuffer(request),
+					message->getFormat(request)->fmt_length))
+			{
+				request->req_operation = Request::req_evaluate;
+				return statement;
+			}
 			// fall into
 
 		case Request::req_evaluate:
@@ -8875,6 +8888,13 @@ void StoreNode::genBlr(DsqlCompilerScratch* dsqlScratch)
 	if (overrideClause.has_value())
 		dsqlScratch->appendUChar(UCHAR(overrideClause.value()));
 
+	// INSERT ... SELECT doesn't see its own records, so it may defer their
+	// keys up to the end of statement. PSQL could read them by the next statement,
+	// and other statements could run between fetches of RETURNING rows.
+
+	if (dsqlRse && !dsqlReturning && !dsqlScratch->isPsql())
+		dsqlScratch->putBlrMarkers(StmtNode::MARK_BULK_INDEX);
+
 	GEN_expr(dsqlScratch, target);
 
 	statement->genBlr(dsqlScratch);
@@ -9190,6 +9210,15 @@ const StmtNode* StoreNode::store(thread_db* tdbb, Request* request, WhichTrigger
 	if ((marks & MARK_BULK_INSERT) || request->req_batch_mode)
 		rpb->rpb_stream_flags |= RPB_s_bulk;
 
+	// Procedures and functions are requests on their own and would read
+	// the relation without the deferred keys
+
+	if ((marks & MARK_BULK_INDEX) &&
+		!(request->getStatement()->flags & Statement::FLAG_ROUTINES))
+	{
+		rpb->rpb_stream_flags |= RPB_s_bulk_index;
+	}
+
 	const auto localTableSource = nodeAs<LocalTableSourceNode>(target);
 	const auto localTable = localTableSource ?
 		request->getStatement()->localTables[localTableSource->tableNumber] :
@@ -9246,6 +9275,9 @@ const StmtNode* StoreNode::store(thread_db* tdbb, Request* request, WhichTrigger
 					VIO_store(tdbb, rpb, transaction);
 					IDX_store(tdbb, rpb, transaction);
 					REPL_store(tdbb, rpb, transaction);
+
+					if (rpb->rpb_stream_flags & RPB_s_bulk_index)
+						IDX_flush_bulk_keys(tdbb, transaction, true);
 				}
 
 				rpb->rpb_number.setValid(true);
@@ -552,6 +552,40 @@ static RefPtr<DsqlStatement> prepareStatement(thread_db* tdbb, dsql_dbb* databas
 			return dsqlStatement;
 	}
 
+	// DSQL resolves metadata through the transaction. With uncommitted DDL it may see
+	// metadata other attachments don't see, so the shared images are neither used nor
+	// built then.
+
+	const auto sharedCache = dbb->dbb_shared_statements;
+	const bool isSharedCacheActive = sharedCache && sharedCache->isActive() &&
+		!(transaction && (transaction->tra_deferred_job || (transaction->tra_flags & TRA_deferred_meta)));
+	const ULONG sharedGeneration = isSharedCacheActive ? sharedCache->getGeneration() : 0;
+
+	if (isSharedCacheActive)
+	{
+		// The statement was already prepared by another attachment, only compile it here
+		const auto image = sharedCache->getImage(tdbb, textStr, clientDialect, isInternalRequest);
+
+		if (image)
+		{
+			MemoryPool* statementPool = database->createPool();
+			Jrd::ContextPoolHolder statementContext(tdbb, statementPool);
+
+			const auto dmlStatement = FB_NEW_POOL(*statementPool) DsqlDmlStatement(*statementPool, database, nullptr);
+			dsqlStatement = dmlStatement;
+
+			dmlStatement->loadSharedImage(tdbb, image, traceResult);
+
+			if (isStatementCacheActive)
+			{
+				database->dbb_statement_cache->putStatement(tdbb,
+					textStr, clientDialect, isInternalRequest, dsqlStatement);
+			}
+
+			return dsqlStatement;
+		}
+	}
+
 	// allocate the statement block, then prepare the statement
 
 	MemoryPool* scratchPool = nullptr;
@@ -582,6 +616,9 @@ static RefPtr<DsqlStatement> prepareStatement(thread_db* tdbb, dsql_dbb* databas
 			if (isInternalRequest)
 				scratch->flags |= DsqlCompilerScratch::FLAG_INTERNAL_REQUEST;
 
+			if (isSharedCacheActive)
+				scratch->flags |= DsqlCompilerScratch::FLAG_SHARED_IMAGE;
+
 			Parser parser(tdbb, *scratchPool, statementPool, scratch, clientDialect,
 				dbDialect,
 				(prepareFlags & IStatement::PREPARE_REQUIRE_SEMICOLON),
@@ -655,6 +692,14 @@ static RefPtr<DsqlStatement> prepareStatement(thread_db* tdbb, dsql_dbb* databas
 				textStr, clientDialect, isInternalRequest, dsqlStatement);
 		}
 
+		if (isSharedCacheActive && dsqlStatement->isDml())
+		{
+			const auto image = static_cast<DsqlDmlStatement*>(dsqlStatement.getPtr())->takeSharedImage();
+
+			if (image)
+				sharedCache->putImage(tdbb, textStr, clientDialect, isInternalRequest, sharedGeneration, image);
+		}
+
 		return dsqlStatement;
 	}
 	catch (const Exception&)
@@ -1565,6 +1565,8 @@ create_clause
 			{
 				$$ = $9;
 			}
+	| BLOCK RANGE INDEX block_range_index_clause
+		{ $$ = $4; }
 	| FUNCTION if_not_exists_opt function_clause
 		{
 			const auto node = $3;
@@ -1780,6 +1782,54 @@ index_definition($createIndexNode)
 		}
 	;
 
+// IF NOT EXISTS is spelled out here instead of if_not_exists_opt,
+// so an index named IF doesn't cost another parser conflict
+%type <createIndexNode> block_range_index_clause
+block_range_index_clause
+	: block_range_index
+		{ $$ = $1; }
+	| IF NOT EXISTS block_range_index
+		{
+			$$ = $4;
+			$$->createIfNotExistsOnly = true;
+		}
+	;
+
+%type <createIndexNode> block_range_index
+block_range_index
+	: symbol_index_name index_active_opt ON simple_table_name
+			{
+				const auto node = newNode<CreateIndexNode>(*$1);
+				node->active = $2;
+				node->blockRange = true;
+				node->relation = $4;
+				$$ = node;
+			}
+		block_range_index_definition(static_cast<CreateIndexNode*>($5))
+			{
+				$$ = $5;
+			}
+	;
+
+// Block range index summarizes a single value per record
+%type block_range_index_definition(<createIndexNode>)
+block_range_index_definition($createIndexNode)
+	: '(' simple_column_name ')'
+		{
+			$createIndexNode->columns = newNode<ValueListNode>($2);
+		}
+	| simple_column_name
+		{
+			$createIndexNode->columns = newNode<ValueListNode>($1);
+		}
+	| computed_by '(' value ')'
+		{
+ 			$createIndexNode->computed = newNode<ValueSourceClause>();
+			$createIndexNode->computed->value = $3;
+			$createIndexNode->computed->source = makeParseStr(YYPOSNARG(2), YYPOSNARG(4));
+		}
+	;
+
 %type index_column_expr(<createIndexNode>)
 index_column_expr($createIndexNode)
 	: column_list
@@ -62,3 +62,10 @@ FB_IMPL_MSG_NO_SYMBOL(GSTAT, 61, "    Expected page inventory page @1")
 FB_IMPL_MSG_NO_SYMBOL(GSTAT, 62, "Generator pages: total @1, encrypted @2, non-crypted @3")
 FB_IMPL_MSG_NO_SYMBOL(GSTAT, 63, "    Table size: @1 bytes")
 FB_IMPL_MSG_NO_SYMBOL(GSTAT, 64, "        Level @1: @2, total length: @3, blob pages: @4")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 65, "    -par    number of parallel threads analyzing data and index pages")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 66, "    -sa     percentage of data pages and index leaf buckets to sample")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 67, "option -par needs a number of threads between 1 and @1")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 68, "option -sa needs a percentage between 1 and 100")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 69, "    Sampled data pages: @1 of @2, estimated average fill: @3 +/- @4 (95% confidence)")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 70, "    Estimated total records: @1 +/- @2 (95% confidence)")
+FB_IMPL_MSG_NO_SYMBOL(GSTAT, 71, "	Sampled leaf buckets: @1 of @2, estimated nodes: @3 +/- @4 (95% confidence)")
@@ -186,6 +186,7 @@
 #undef HAVE_XDR_HYPER
 #undef HAVE_PREAD
 #undef HAVE_PWRITE
+#undef HAVE_PWRITEV
 #define HAVE_GETCWD
 #undef HAVE_GETWD
 #undef HAVE_SETMNTENT
@@ -299,6 +299,14 @@ public:
 
 	ULONG getCurrentPage(thread_db* tdbb) const;
 	UCHAR getCurrentState(thread_db* tdbb) const;
+
+	// No crypt state change is in progress, so the page image passed to
+	// IOCallback stays valid after write() returns
+	bool isSteady() const
+	{
+		return !process && !slowIO;
+	}
+
 	const char* getKeyName() const;
 	const char* getPluginName() const;
 	Thread::Handle getCryptThreadHandle() const
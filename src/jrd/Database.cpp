@@ -38,6 +38,7 @@
 #include "../jrd/tpc_proto.h"
 #include "../jrd/lck_proto.h"
 #include "../jrd/CryptoManager.h"
+#include "../dsql/DsqlStatementCache.h"
 #include "../jrd/os/pio_proto.h"
 #include "../common/os/os_utils.h"
 //#include "../dsql/Parser.h"
@@ -161,13 +162,6 @@ namespace Jrd
 			dbb_linger_timer->destroy();
 		}
 
-		{ // scope
-			SyncLockGuard guard(&dbb_sortbuf_sync, SYNC_EXCLUSIVE, "Database::~Database");
-
-			while (dbb_sort_buffers.hasData())
-				delete[] dbb_sort_buffers.pop();
-		}
-
 		{ // scope
 			SyncLockGuard guard(&dbb_pools_sync, SYNC_EXCLUSIVE, "Database::~Database");
 
@@ -179,6 +173,7 @@ namespace Jrd
 
 		delete dbb_tip_cache;
 		delete dbb_monitoring_data;
+		delete dbb_shared_statements;
 		delete dbb_backup_manager;
 		delete dbb_crypto_manager;
 	}
@@ -568,6 +563,65 @@ namespace Jrd
 		reset();
 	}
 
+	// Database::SortBufferCache class implementation
+
+	Database::SortBufferCache::~SortBufferCache()
+	{
+		for (auto& node : nodes)
+		{
+			SyncLockGuard guard(&node.sync, SYNC_EXCLUSIVE, "Database::SortBufferCache::~SortBufferCache");
+
+			for (unsigned i = 0; i < node.count; i++)
+				delete[] node.buffers[i];
+		}
+	}
+
+	UCHAR* Database::SortBufferCache::get()
+	{
+		// Buffers cached by other nodes are not used, as new memory
+		// will be allocated at the current node anyway
+
+		Node& node = nodes[os_utils::getCurrentNumaNode() % MAX_NODES];
+
+		// Unlocked pre-check avoids taking the lock when the node is empty
+
+		if (node.count.load(std::memory_order_relaxed))
+		{
+			SyncLockGuard guard(&node.sync, SYNC_EXCLUSIVE, FB_FUNCTION);
+
+			const unsigned count = node.count.load(std::memory_order_relaxed);
+
+			if (count)
+			{
+				node.count.store(count - 1, std::memory_order_relaxed);
+				return node.buffers[count - 1];
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool Database::SortBufferCache::put(UCHAR* buffer)
+	{
+		Node& node = nodes[os_utils::getCurrentNumaNode() % MAX_NODES];
+
+		if (node.count.load(std::memory_order_relaxed) < MAX_BUFFERS)
+		{
+			SyncLockGuard guard(&node.sync, SYNC_EXCLUSIVE, FB_FUNCTION);
+
+			const unsigned count = node.count.load(std::memory_order_relaxed);
+
+			if (count < MAX_BUFFERS)
+			{
+				node.buffers[count] = buffer;
+				node.count.store(count + 1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	// Database::GlobalObjectHolder class implementation
 
 	int Database::GlobalObjectHolder::release() const
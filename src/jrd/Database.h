@@ -89,6 +89,7 @@ class TipCache;
 class BackupManager;
 class ExternalFileDirectoryList;
 class MonitoringData;
+class DsqlSharedStatementCache;
 class GarbageCollector;
 class CryptoManager;
 class KeywordsMap;
@@ -389,6 +390,31 @@ public:
 		bool active;
 	};
 
+	// Cache of sort buffers ready for reuse. It's split by NUMA node of
+	// the releasing thread, thus sorts get memory local to the CPU they
+	// run on and parallel workers don't contend on a single lock.
+	class SortBufferCache
+	{
+	public:
+		static const unsigned MAX_NODES = 4;
+		static const unsigned MAX_BUFFERS = 8;	// per node
+
+		~SortBufferCache();
+
+		UCHAR* get();
+		bool put(UCHAR* buffer);
+
+	private:
+		struct Node
+		{
+			Firebird::SyncObject sync;
+			std::atomic<unsigned> count = 0;	// modified under sync only
+			UCHAR* buffers[MAX_BUFFERS];
+		};
+
+		Node nodes[MAX_NODES];
+	};
+
 	static Database* create(Firebird::IPluginConfig* pConf, bool shared)
 	{
 		Firebird::MemoryStats temp_stats;
@@ -451,6 +477,7 @@ public:
 	BlobFilter*	dbb_blob_filters;		// known blob filters
 
 	MonitoringData*			dbb_monitoring_data;	// monitoring data
+	DsqlSharedStatementCache*	dbb_shared_statements;	// DSQL statements prepared by all attachments
 
 private:
 	Firebird::string dbb_file_id;		// system-wide unique file ID
@@ -477,10 +504,8 @@ public:
 	USHORT dbb_max_records;				// max record per data page
 	USHORT dbb_max_idx;					// max number of indexes on a root page
 
-#ifdef SUPERSERVER_V2
 	USHORT dbb_prefetch_sequence;		// sequence to pace frequency of prefetch requests
 	USHORT dbb_prefetch_pages;			// prefetch pages per request
-#endif
 
 	Firebird::PathName dbb_filename;	// filename string
 	Firebird::PathName dbb_database_name;	// database visible name (file name or alias)
@@ -492,8 +517,7 @@ public:
 	Firebird::SyncObject			dbb_pools_sync;
 	Firebird::Array<MemoryPool*>	dbb_pools;		// pools
 
-	Firebird::SyncObject			dbb_sortbuf_sync;
-	Firebird::Array<UCHAR*>			dbb_sort_buffers;	// sort buffers ready for reuse
+	SortBufferCache					dbb_sort_buffers;	// sort buffers ready for reuse
 
 	TraNumber dbb_oldest_active;		// Cached "oldest active" transaction
 	TraNumber dbb_oldest_transaction;	// Cached "oldest interesting" transaction
@@ -622,7 +646,6 @@ private:
 #endif
 		dbb_owner(*p),
 		dbb_pools(*p, 4),
-		dbb_sort_buffers(*p),
 		dbb_gc_fini(*p, garbage_collector, THREAD_medium),
 		dbb_stats(*p),
 		dbb_lock_owner_id(getLockOwnerId()),
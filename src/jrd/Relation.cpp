@@ -598,4 +598,6 @@ void RelationPages::free(RelationPages*& nextFree)
 
 	dpMap.clear();
 	dpMapMark = 0;
+
+	lastLeafMap.clear();
 }
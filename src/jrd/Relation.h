@@ -97,7 +97,8 @@ public:
 		  rel_pg_space_id(DB_PAGE_SPACE), rel_next_free(NULL),
 		  useCount(0),
 		  dpMap(pool),
-		  dpMapMark(0)
+		  dpMapMark(0),
+		  lastLeafMap(pool)
 	{}
 
 	inline SLONG addRef()
@@ -172,6 +173,32 @@ public:
 		dpMapMark -= minMark;
 	}
 
+	// Rightmost leaf page of index, where monotonically increasing keys are
+	// appended. It's valid while index root page keeps the same incarnation.
+
+	ULONG getLastLeaf(USHORT indexId, SLONG rootIncarnation) const
+	{
+		FB_SIZE_T pos;
+		if (lastLeafMap.find(indexId, pos) && lastLeafMap[pos].rootIncarnation == rootIncarnation)
+			return lastLeafMap[pos].page;
+
+		return 0;
+	}
+
+	void setLastLeaf(USHORT indexId, SLONG rootIncarnation, ULONG page)
+	{
+		FB_SIZE_T pos;
+		if (lastLeafMap.find(indexId, pos))
+		{
+			if (page)
+				lastLeafMap[pos] = {indexId, page, rootIncarnation};
+			else
+				lastLeafMap.remove(pos);
+		}
+		else if (page)
+			lastLeafMap.insert(pos, {indexId, page, rootIncarnation});
+	}
+
 private:
 	RelationPages*	rel_next_free;
 	SLONG	useCount;
@@ -193,6 +220,20 @@ private:
 	Firebird::SortedArray<DPItem, Firebird::InlineStorage<DPItem, MAX_DPMAP_ITEMS>, ULONG, DPItem> dpMap;
 	ULONG dpMapMark;
 
+	struct LeafItem
+	{
+		USHORT indexId;
+		ULONG page;
+		SLONG rootIncarnation;
+
+		static USHORT generate(const LeafItem& item)
+		{
+			return item.indexId;
+		}
+	};
+
+	Firebird::SortedArray<LeafItem, Firebird::InlineStorage<LeafItem, 4>, USHORT, LeafItem> lastLeafMap;
+
 friend class jrd_rel;
 };
 
@@ -137,6 +137,7 @@ Statement::Statement(thread_db* tdbb, MemoryPool* p, CompilerScratch* csb)
 				{
 					Routine* routine = resource->rsc_routine;
 					routine->addRef();
+					flags |= FLAG_ROUTINES;
 
 #ifdef DEBUG_PROCS
 					string buffer;
@@ -38,6 +38,7 @@ public:
 	static const unsigned FLAG_INTERNAL		= 0x02;
 	static const unsigned FLAG_IGNORE_PERM	= 0x04;
 	//static const unsigned FLAG_VERSION4	= 0x08;
+	static const unsigned FLAG_ROUTINES		= 0x10;	// calls procedures or functions
 	static const unsigned FLAG_POWERFUL		= FLAG_SYS_TRIGGER | FLAG_INTERNAL | FLAG_IGNORE_PERM;
 
 	//static const unsigned MAP_LENGTH;		// CVC: Moved to dsql/Nodes.h as STREAM_MAP_LENGTH
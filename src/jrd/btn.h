@@ -276,6 +276,30 @@ struct IndexJumpNode
 	UCHAR* writeJumpNode(UCHAR* pagePointer);
 };
 
+// Return the length of the common part of two byte strings. Index keys
+// often share long runs beyond the stored prefix (compound keys, jump node
+// targets), so equal runs are compared a machine word at a time.
+
+inline USHORT matchLength(const UCHAR* p1, const UCHAR* p2, FB_SIZE_T length)
+{
+	FB_SIZE_T n = 0;
+
+	for (; n + sizeof(FB_UINT64) <= length; n += sizeof(FB_UINT64))
+	{
+		FB_UINT64 word1, word2;
+		memcpy(&word1, p1 + n, sizeof(FB_UINT64));
+		memcpy(&word2, p2 + n, sizeof(FB_UINT64));
+
+		if (word1 != word2)
+			break;
+	}
+
+	while (n < length && p1[n] == p2[n])
+		n++;
+
+	return (USHORT) n;
+}
+
 } // namespace Jrd
 
 #endif // JRD_BTN_H
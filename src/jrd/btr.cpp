@@ -185,6 +185,32 @@ namespace
 		temporary_key jumpKey;
 	};
 
+	// Number of block range summaries fitting a summary page
+
+	inline ULONG rangesPerPage(const Database* dbb, USHORT keyLength)
+	{
+		return (dbb->dbb_page_size - RNG_SIZE) / rangeSummaryLength(keyLength);
+	}
+
+	// Number of summary pages a directory page can list
+
+	inline ULONG rangeDirectorySize(const Database* dbb)
+	{
+		return (dbb->dbb_page_size - RNG_SIZE) / sizeof(ULONG);
+	}
+
+	// Compare two keys the way the b-tree orders them
+
+	int compareRangeKeys(const UCHAR* key1, USHORT length1, const UCHAR* key2, USHORT length2)
+	{
+		const int result = memcmp(key1, key2, MIN(length1, length2));
+
+		if (result)
+			return result;
+
+		return (length1 < length2) ? -1 : (length1 > length2) ? 1 : 0;
+	}
+
 } // namespace
 
 static ULONG add_node(thread_db*, WIN*, index_insertion*, temporary_key*, RecordNumber*,
@@ -194,7 +220,9 @@ static void compress(thread_db*, const dsc*, const SSHORT scale, temporary_key*,
 static USHORT compress_root(thread_db*, index_root_page*);
 static void copy_key(const temporary_key*, temporary_key*);
 static contents delete_node(thread_db*, WIN*, UCHAR*);
+static void delete_ranges(thread_db*, USHORT, USHORT, PageNumber, PageNumber);
 static void delete_tree(thread_db*, USHORT, USHORT, PageNumber, PageNumber);
+static void evaluate_ranges(thread_db*, const IndexRetrieval*, RecordBitmap**, RecordBitmap*);
 static ULONG fast_load(thread_db*, IndexCreation&, SelectivityList&);
 
 static index_root_page* fetch_root(thread_db*, WIN*, const jrd_rel*, const RelationPages*);
@@ -211,9 +239,12 @@ static contents garbage_collect(thread_db*, WIN*, ULONG);
 static void generate_jump_nodes(thread_db*, btree_page*, JumpNodeList*, USHORT,
 								USHORT*, USHORT*, USHORT*, USHORT);
 
+static ULONG insert_last_leaf(thread_db*, WIN*, WIN*, index_insertion*, temporary_key*,
+	RecordNumber*);
 static ULONG insert_node(thread_db*, WIN*, index_insertion*, temporary_key*,
 						 RecordNumber*, ULONG*, ULONG*);
 
+static ULONG load_ranges(thread_db*, IndexCreation&, SelectivityList&);
 static INT64_KEY make_int64_key(SINT64, SSHORT);
 #ifdef DEBUG_INDEXKEY
 static void print_int64_key(SINT64, SSHORT, INT64_KEY);
@@ -224,6 +255,7 @@ static contents remove_leaf_node(thread_db*, index_insertion*, WIN*);
 static bool scan(thread_db*, UCHAR*, RecordBitmap**, RecordBitmap*, index_desc*,
 				 const IndexRetrieval*, USHORT, temporary_key*,
 				 bool&, const temporary_key&, USHORT);
+static void update_range(thread_db*, jrd_rel*, ULONG, RecordNumber, const UCHAR*, USHORT);
 static void update_selectivity(index_root_page*, USHORT, const SelectivityList&);
 static void checkForLowerKeySkip(bool&, const bool, const IndexNode&, const temporary_key&,
 								 const index_desc&, const IndexRetrieval*);
@@ -801,6 +833,147 @@ void IndexScanListIterator::makeKeys(thread_db* tdbb, temporary_key* lower, temp
 }
 
 
+// IndexSkipScanIterator class
+
+IndexSkipScanIterator::IndexSkipScanIterator(thread_db* tdbb, const IndexRetrieval* retrieval,
+											 const temporary_key* lower, const temporary_key* upper)
+	: m_retrieval(retrieval)
+{
+	fb_assert(retrieval->irb_generic & irb_skip_scan);
+	fb_assert(!(retrieval->irb_desc.idx_flags & idx_descending));
+	fb_assert(!lower->key_next && !upper->key_next);
+
+	// Bounds are built with a placeholder (empty) leading segment,
+	// thus they're actually the search keys for the trailing segments
+
+	copy_key(lower, &m_lower);
+	copy_key(upper, &m_upper);
+
+	m_prefix.key_flags = 0;
+	m_prefix.key_length = 0;
+	m_prefix.key_nulls = 0;
+}
+
+bool IndexSkipScanIterator::getNext(thread_db* tdbb, temporary_key* lower, temporary_key* upper)
+{
+/**************************************
+ *
+ *	g e t N e x t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Locate the next distinct value of the leading index segment
+ *	and build the lower/upper bounds for the trailing segments
+ *	prefixed with that value. Return false at the end of index.
+ *
+ **************************************/
+	const auto relPages = m_retrieval->irb_relation->getPages(tdbb);
+	const auto idxCount = m_retrieval->irb_desc.idx_count;
+
+	// Seek past all keys starting with the current leading value. Keys having the same
+	// leading value continue with the marker of some trailing segment (that is less than
+	// idx_count), so the marker of the leading segment is greater than any of them.
+
+	temporary_key seek;
+	seek.key_flags = 0;
+	seek.key_nulls = 0;
+	seek.key_length = 0;
+
+	if (!m_first)
+	{
+		memcpy(seek.key_data, m_prefix.key_data, m_prefix.key_length);
+		seek.key_length = m_prefix.key_length;
+		seek.key_data[seek.key_length++] = (UCHAR) idxCount;
+	}
+
+	m_first = false;
+
+	WIN window(relPages->rel_pg_space_id, -1);
+	window.win_page = relPages->rel_index_root;
+	index_root_page* const rpage = (index_root_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_root);
+
+	index_desc idx;
+	if (!BTR_description(tdbb, m_retrieval->irb_relation, rpage, &idx, m_retrieval->irb_index))
+	{
+		CCH_RELEASE(tdbb, &window);
+		IBERROR(260);	// msg 260 index unexpectedly deleted
+	}
+
+	btree_page* page = (btree_page*) CCH_HANDOFF(tdbb, &window, idx.idx_root, LCK_read, pag_index);
+
+	while (page->btr_level > 0)
+	{
+		const ULONG number = find_page(page, &seek, &idx, NO_VALUE, 0);
+		const ULONG next = (number != END_BUCKET) ? number : page->btr_sibling;
+		page = (btree_page*) CCH_HANDOFF(tdbb, &window, next, LCK_read, pag_index);
+	}
+
+	temporary_key found;
+	UCHAR* pointer;
+	USHORT prefix;
+
+	while (!(pointer = find_node_start_point(page, &seek, found.key_data, &prefix, false, 0)))
+		page = (btree_page*) CCH_HANDOFF(tdbb, &window, page->btr_sibling, LCK_read, pag_index);
+
+	IndexNode node;
+	node.readNode(pointer, true);
+
+	if (node.isEndLevel)
+	{
+		CCH_RELEASE(tdbb, &window);
+		return false;
+	}
+
+	// Extract the leading segment: groups of STUFF_COUNT bytes marked with idx_count
+
+	const UCHAR* const data = found.key_data;
+	const USHORT keyLength = node.prefix + node.length;
+	USHORT length = 0;
+
+	while (length < keyLength && data[length] == idxCount)
+		length += STUFF_COUNT + 1;
+
+	length = MIN(length, keyLength);
+	memcpy(m_prefix.key_data, data, length);
+
+	CCH_RELEASE(tdbb, &window);
+
+	// Trailing zeroes may be truncated at the end of key, restore the padding
+	// so that the trailing segments start at the proper group boundary
+
+	while (length % (STUFF_COUNT + 1))
+		m_prefix.key_data[length++] = 0;
+
+	m_prefix.key_length = length;
+
+	makeKey(tdbb, &m_lower, lower);
+	makeKey(tdbb, &m_upper, upper);
+
+	return true;
+}
+
+void IndexSkipScanIterator::makeKey(thread_db* tdbb, const temporary_key* suffix,
+									temporary_key* key) const
+{
+	const auto dbb = tdbb->getDatabase();
+
+	if (m_prefix.key_length + suffix->key_length >= dbb->getMaxIndexKeyLength())
+	{
+		index_desc temp_idx = m_retrieval->irb_desc;
+		IndexErrorContext context(m_retrieval->irb_relation, &temp_idx);
+		context.raise(tdbb, idx_e_keytoobig);
+	}
+
+	memcpy(key->key_data, m_prefix.key_data, m_prefix.key_length);
+	memcpy(key->key_data + m_prefix.key_length, suffix->key_data, suffix->key_length);
+	key->key_length = m_prefix.key_length + suffix->key_length;
+	key->key_flags = suffix->key_flags;
+	key->key_nulls = suffix->key_nulls;
+	key->key_next.reset();
+}
+
+
 void BTR_all(thread_db* tdbb, jrd_rel* relation, IndexDescList& idxList, RelationPages* relPages)
 {
 /**************************************
@@ -882,7 +1055,8 @@ void BTR_create(thread_db* tdbb,
 	index_desc* const idx = creation.index;
 
 	// Now that the index id has been checked out, create the index.
-	idx->idx_root = fast_load(tdbb, creation, selectivity);
+	idx->idx_root = (idx->idx_flags & idx_block_range) ?
+		load_ranges(tdbb, creation, selectivity) : fast_load(tdbb, creation, selectivity);
 
 	// Index is created.  Go back to the index root page and update it to
 	// point to the index.
@@ -897,6 +1071,224 @@ void BTR_create(thread_db* tdbb,
 }
 
 
+bool BTR_decodable_key(const index_desc* idx, const Format* format)
+{
+/**************************************
+ *
+ *	B T R _ d e c o d a b l e _ k e y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Check whether the field values could be restored exactly
+ *	from the index key, see BTR_decode_key().
+ *
+ **************************************/
+
+	if (idx->idx_flags & (idx_expression | idx_descending | idx_block_range))
+		return false;
+
+	for (USHORT i = 0; i < idx->idx_count; i++)
+	{
+		const auto& tail = idx->idx_rpt[i];
+
+		if (tail.idx_field >= format->fmt_count)
+			return false;
+
+		const UCHAR dtype = format->fmt_desc[tail.idx_field].dsc_dtype;
+
+		switch (tail.idx_itype)
+		{
+			case idx_numeric:
+				if (dtype != dtype_short && dtype != dtype_long &&
+					dtype != dtype_real && dtype != dtype_double)
+				{
+					return false;
+				}
+				break;
+
+			case idx_sql_date:
+				if (dtype != dtype_sql_date)
+					return false;
+				break;
+
+			case idx_sql_time:
+				if (dtype != dtype_sql_time)
+					return false;
+				break;
+
+			case idx_timestamp:
+				if (dtype != dtype_timestamp)
+					return false;
+				break;
+
+			case idx_boolean:
+				if (dtype != dtype_boolean)
+					return false;
+				break;
+
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+void BTR_decode_key(thread_db* tdbb, const index_desc* idx, const temporary_key* key,
+					Record* record)
+{
+/**************************************
+ *
+ *	B T R _ d e c o d e _ k e y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Restore the values of indexed fields from the (ascending) index key.
+ *	This is the reverse of compress() for the key types accepted by
+ *	BTR_decodable_key(). Other fields of the record are set to NULL.
+ *
+ **************************************/
+	const size_t MAX_VALUE_LENGTH = sizeof(double) + STUFF_COUNT;
+
+	UCHAR values[MAX_INDEX_SEGMENTS][MAX_VALUE_LENGTH];
+	USHORT lengths[MAX_INDEX_SEGMENTS];
+	memset(values, 0, sizeof(values));
+	memset(lengths, 0, sizeof(lengths));
+
+	// Split the key into segments. Trailing zeroes are chopped off the key values
+	// and the compound key segments are padded with zeroes, so missing bytes are zeroes.
+	// NULLs are stored as empty segments.
+
+	if (idx->idx_count == 1)
+	{
+		lengths[0] = MIN(key->key_length, MAX_VALUE_LENGTH);
+		memcpy(values[0], key->key_data, lengths[0]);
+	}
+	else
+	{
+		const UCHAR* p = key->key_data;
+		const UCHAR* const end = p + key->key_length;
+
+		while (p < end)
+		{
+			const int segno = idx->idx_count - *p++;
+
+			if (segno < 0 || segno >= idx->idx_count)
+				BUGCHECK(204);	// msg 204 index inconsistent
+
+			for (int n = 0; n < STUFF_COUNT && p < end; n++, p++)
+			{
+				if (lengths[segno] < MAX_VALUE_LENGTH)
+					values[segno][lengths[segno]++] = *p;
+			}
+		}
+	}
+
+	record->nullify();
+
+	const Format* const format = record->getFormat();
+
+	for (USHORT i = 0; i < idx->idx_count; i++)
+	{
+		const auto& tail = idx->idx_rpt[i];
+
+		if (!lengths[i])
+			continue;
+
+		UCHAR* const data = values[i];
+		size_t length = sizeof(double);
+
+		switch (tail.idx_itype)
+		{
+			case idx_sql_date:
+			case idx_sql_time:
+				length = sizeof(SLONG);
+				break;
+
+			case idx_boolean:
+				length = sizeof(UCHAR);
+				break;
+		}
+
+		// Positive numbers (and non-numeric values) have the sign bit zapped,
+		// negative numbers are complemented as a whole
+
+		if (tail.idx_itype != idx_numeric || (data[0] & 0x80))
+			data[0] ^= 0x80;
+		else
+		{
+			for (size_t n = 0; n < length; n++)
+				data[n] = ~data[n];
+		}
+
+		union
+		{
+			double temp_double;
+			SLONG temp_slong;
+			SINT64 temp_sint64;
+			UCHAR temp_char[sizeof(double)];
+		} temp;
+
+#ifndef WORDS_BIGENDIAN
+		for (size_t n = 0; n < length; n++)
+			temp.temp_char[n] = data[length - n - 1];
+#else
+		memcpy(temp.temp_char, data, length);
+#endif
+
+		dsc from;
+		GDS_TIMESTAMP timestamp;
+
+		switch (tail.idx_itype)
+		{
+			case idx_numeric:
+				from.makeDouble(&temp.temp_double);
+				break;
+
+			case idx_sql_date:
+				from.makeDate((GDS_DATE*) &temp.temp_slong);
+				break;
+
+			case idx_sql_time:
+				from.makeTime((GDS_TIME*) &temp.temp_slong);
+				break;
+
+			case idx_timestamp:
+			{
+				const SINT64 ticksPerDay =
+					NoThrowTimeStamp::SECONDS_PER_DAY * ISC_TIME_SECONDS_PRECISION;
+
+				SINT64 date = temp.temp_sint64 / ticksPerDay;
+				if (temp.temp_sint64 % ticksPerDay < 0)
+					date--;
+
+				timestamp.timestamp_date = (GDS_DATE) date;
+				timestamp.timestamp_time = (GDS_TIME) (temp.temp_sint64 - date * ticksPerDay);
+				from.makeTimestamp(&timestamp);
+				break;
+			}
+
+			case idx_boolean:
+				from.makeBoolean(temp.temp_char);
+				break;
+
+			default:
+				fb_assert(false);
+				continue;
+		}
+
+		dsc to = format->fmt_desc[tail.idx_field];
+		to.dsc_address = record->getData() + (IPTR) to.dsc_address;
+
+		MOV_move(tdbb, &from, &to);
+		record->clearNull(tail.idx_field);
+	}
+}
+
+
 bool BTR_delete_index(thread_db* tdbb, WIN* window, USHORT id)
 {
 /**************************************
@@ -932,9 +1324,14 @@ bool BTR_delete_index(thread_db* tdbb, WIN* window, USHORT id)
 		irt_desc->setEmpty();
 		const PageNumber prior = window->win_page;
 		const USHORT relation_id = root->irt_relation;
+		const bool blockRange = (irt_desc->irt_flags & irt_block_range);
 
 		CCH_RELEASE(tdbb, window);
-		delete_tree(tdbb, relation_id, id, next, prior);
+
+		if (blockRange)
+			delete_ranges(tdbb, relation_id, id, next, prior);
+		else
+			delete_tree(tdbb, relation_id, id, next, prior);
 	}
 
 	return tree_exists;
@@ -1140,6 +1537,12 @@ void BTR_evaluate(thread_db* tdbb, const IndexRetrieval* retrieval, RecordBitmap
  **************************************/
 	SET_TDBB(tdbb);
 
+	if (retrieval->irb_desc.idx_flags & idx_block_range)
+	{
+		evaluate_ranges(tdbb, retrieval, bitmap, bitmap_and);
+		return;
+	}
+
 	RelationPages* relPages = retrieval->irb_relation->getPages(tdbb);
 	WIN window(relPages->rel_pg_space_id, -1);
 
@@ -1160,6 +1563,15 @@ void BTR_evaluate(thread_db* tdbb, const IndexRetrieval* retrieval, RecordBitmap
 	if (!BTR_make_bounds(tdbb, retrieval, iterator, lower, upper, forceInclFlag))
 		return;
 
+	// Skip scan probes the index once per every distinct value of the leading segment
+
+	AutoPtr<IndexSkipScanIterator> skipIterator =
+		(retrieval->irb_generic & irb_skip_scan) ? FB_NEW_POOL(*tdbb->getDefaultPool())
+			IndexSkipScanIterator(tdbb, retrieval, lower, upper) : nullptr;
+
+	if (skipIterator && !skipIterator->getNext(tdbb, lower, upper))
+		return;
+
 	index_desc idx;
 	btree_page* page = nullptr;
 
@@ -1284,7 +1696,7 @@ void BTR_evaluate(thread_db* tdbb, const IndexRetrieval* retrieval, RecordBitmap
 			if (!(retrieval->irb_generic & irb_root_list_scan))
 				continue;
 		}
-		else
+		else if (!skipIterator)
 		{
 			lower = lower->key_next.get();
 			upper = upper->key_next.get();
@@ -1293,6 +1705,11 @@ void BTR_evaluate(thread_db* tdbb, const IndexRetrieval* retrieval, RecordBitmap
 		CCH_RELEASE(tdbb, &window);
 		page = nullptr;
 
+		// Switch to the next value of the leading segment, the lookup is restarted from the root
+
+		if (skipIterator && !skipIterator->getNext(tdbb, lower, upper))
+			break;
+
 	} while (lower && upper);
 }
 
@@ -1424,18 +1841,24 @@ void BTR_insert(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 	SET_TDBB(tdbb);
 
 	index_desc* idx = insertion->iib_descriptor;
-	RelationPages* relPages = insertion->iib_relation->getPages(tdbb);
-	WIN window(relPages->rel_pg_space_id, idx->idx_root);
-	btree_page* bucket = (btree_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_index);
-	UCHAR root_level = bucket->btr_level;
 
-	if (bucket->btr_level == 0)
+	if (idx->idx_flags & idx_block_range)
 	{
-		CCH_RELEASE(tdbb, &window);
-		CCH_FETCH(tdbb, &window, LCK_write, pag_index);
+		// Block range summaries are only widened, so the index root is not needed
+		CCH_RELEASE(tdbb, root_window);
+
+		for (const temporary_key* key = insertion->iib_key; key; key = key->key_next.get())
+		{
+			update_range(tdbb, insertion->iib_relation, idx->idx_root, insertion->iib_number,
+				key->key_data, key->key_length);
+		}
+
+		return;
 	}
 
-	CCH_RELEASE(tdbb, root_window);
+	RelationPages* relPages = insertion->iib_relation->getPages(tdbb);
+	WIN window(relPages->rel_pg_space_id, idx->idx_root);
+	btree_page* bucket = NULL;
 
 	temporary_key key;
 	key.key_flags = 0;
@@ -1443,8 +1866,34 @@ void BTR_insert(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 
 	RecordNumber recordNumber(0);
 	BtrPageGCLock lock(tdbb);
-	insertion->iib_dont_gc_lock = &lock;
-	ULONG split_page = add_node(tdbb, &window, insertion, &key, &recordNumber, NULL, NULL);
+	BtrPageGCLock leafLock(tdbb);
+	insertion->iib_dont_gc_lock = &leafLock;
+	insertion->iib_root_incarnation = CCH_get_incarnation(root_window);
+
+	// Keys generated by sequences or timestamps are appended to the rightmost
+	// leaf page, try it before descending from the top of the index
+	UCHAR root_level = 0;
+	ULONG split_page = insert_last_leaf(tdbb, root_window, &window, insertion, &key, &recordNumber);
+	const bool lastLeaf = (split_page != NO_VALUE_PAGE);
+
+	if (!lastLeaf)
+	{
+		insertion->iib_dont_gc_lock = &lock;
+		window.win_page = idx->idx_root;
+		bucket = (btree_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_index);
+		root_level = bucket->btr_level;
+
+		if (bucket->btr_level == 0)
+		{
+			CCH_RELEASE(tdbb, &window);
+			CCH_FETCH(tdbb, &window, LCK_write, pag_index);
+		}
+
+		CCH_RELEASE(tdbb, root_window);
+
+		split_page = add_node(tdbb, &window, insertion, &key, &recordNumber, NULL, NULL);
+	}
+
 	if (split_page == NO_SPLIT)
 		return;
 
@@ -1455,7 +1904,7 @@ void BTR_insert(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 	window.win_page = root->irt_rpt[idx->idx_id].getRoot();
 	bucket = (btree_page*) CCH_FETCH(tdbb, &window, LCK_write, pag_index);
 
-	if (window.win_page.getPageNum() != idx->idx_root)
+	if (window.win_page.getPageNum() != idx->idx_root || lastLeaf)
 	{
 		// AB: It could be possible that the "top" page meanwhile was changed by
 		// another insert. In that case we are going to insert our split_page
@@ -1468,7 +1917,11 @@ void BTR_insert(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 		// could be splitted again. Thus, to avoid endless loop we won't release
 		// root page while propagate our split page.
 
-		lock.enablePageGC(tdbb);
+		// The same is done when the rightmost leaf page was split by
+		// insert_last_leaf(): its split page is propagated from the top.
+
+		if (!lastLeaf)
+			lock.enablePageGC(tdbb);
 
 		if (bucket->btr_level < root_level + 1)
 		{
@@ -1482,6 +1935,7 @@ void BTR_insert(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 		propagate.iib_descriptor->idx_root = window.win_page.getPageNum();
 		propagate.iib_key = &key;
 		propagate.iib_btr_level = root_level + 1;
+		propagate.iib_dont_gc_lock = &lock;
 
 		temporary_key ret_key;
 		ret_key.key_flags = 0;
@@ -1489,6 +1943,10 @@ void BTR_insert(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 
 		split_page = add_node(tdbb, &window, &propagate, &ret_key, &recordNumber, NULL, NULL);
 
+		// split of the rightmost leaf page is propagated, allow its GC now
+		if (lastLeaf)
+			leafLock.enablePageGC(tdbb);
+
 		if (split_page == NO_SPLIT)
 		{
 			CCH_RELEASE(tdbb, root_window);
@@ -1926,9 +2384,13 @@ idx_e BTR_make_key(thread_db* tdbb,
 					return idx_e_keytoobig;
 			}
 
-			const auto desc = EVL_expr(tdbb, request, *exprs++);
+			// Missing expression is a placeholder for the leading segment of the skip scan,
+			// it's encoded as an empty segment but is not considered being NULL
+
+			const auto expr = *exprs++;
+			const auto desc = expr ? EVL_expr(tdbb, request, expr) : nullptr;
 
-			if (!desc)
+			if (!desc && expr)
 				key->key_nulls |= 1 << n;
 
 			temp.key_flags |= key_empty;
@@ -2186,6 +2648,14 @@ void BTR_remove(thread_db* tdbb, WIN* root_window, index_insertion* insertion)
 
 	//const Database* dbb = tdbb->getDatabase();
 	index_desc* idx = insertion->iib_descriptor;
+
+	// Block range summaries never shrink, they are rebuilt together with the index
+	if (idx->idx_flags & idx_block_range)
+	{
+		CCH_RELEASE(tdbb, root_window);
+		return;
+	}
+
 	RelationPages* relPages = insertion->iib_relation->getPages(tdbb);
 	WIN window(relPages->rel_pg_space_id, idx->idx_root);
 	btree_page* page = (btree_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_index);
@@ -2416,6 +2886,21 @@ void BTR_selectivity(thread_db* tdbb, jrd_rel* relation, USHORT id, SelectivityL
 	const bool descending = (root->irt_rpt[id].irt_flags & irt_descending);
 	const ULONG segments = root->irt_rpt[id].irt_keys;
 
+	// Block range index keeps no keys to count, report the statistics
+	// collected when the index was created
+
+	if (root->irt_rpt[id].irt_flags & irt_block_range)
+	{
+		const irtd* key_descriptor = (irtd*) ((UCHAR*) root + root->irt_rpt[id].irt_desc);
+
+		selectivity.grow(segments);
+		for (ULONG i = 0; i < segments; i++)
+			selectivity[i] = key_descriptor[i].irtd_selectivity;
+
+		CCH_RELEASE(tdbb, &window);
+		return;
+	}
+
 	window.win_flags = WIN_large_scan;
 	window.win_scans = 1;
 	btree_page* bucket = (btree_page*) CCH_HANDOFF(tdbb, &window, page, LCK_read, pag_index);
@@ -3672,6 +4157,55 @@ static contents delete_node(thread_db* tdbb, WIN* window, UCHAR* pointer)
 }
 
 
+static void delete_ranges(thread_db* tdbb,
+						  USHORT rel_id, USHORT idx_id, PageNumber directory, PageNumber prior)
+{
+/**************************************
+ *
+ *	d e l e t e _ r a n g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Release block range index pages back to free list.
+ *
+ **************************************/
+
+	SET_TDBB(tdbb);
+	WIN window(directory);
+
+	range_page* page = (range_page*) CCH_FETCH(tdbb, &window, LCK_write, 0);
+
+	// Stop at a damaged pointer, see delete_tree()
+	if (page->rng_header.pag_type != pag_range || !(page->rng_header.pag_flags & rng_directory) ||
+		page->rng_id != idx_id || page->rng_relation != rel_id)
+	{
+		CCH_RELEASE(tdbb, &window);
+		return;
+	}
+
+	HalfStaticArray<ULONG, 16> pages;
+	const ULONG count = MIN(page->rng_count, rangeDirectorySize(tdbb->getDatabase()));
+
+	for (ULONG i = 0; i < count; i++)
+	{
+		if (page->rng_data[i])
+			pages.add(page->rng_data[i]);
+	}
+
+	CCH_RELEASE_TAIL(tdbb, &window);
+	PAG_release_page(tdbb, directory, prior);
+	prior = directory;
+
+	for (const ULONG* iter = pages.begin(); iter != pages.end(); ++iter)
+	{
+		const PageNumber number(directory.getPageSpaceID(), *iter);
+		PAG_release_page(tdbb, number, prior);
+		prior = number;
+	}
+}
+
+
 static void delete_tree(thread_db* tdbb,
 						USHORT rel_id, USHORT idx_id, PageNumber next, PageNumber prior)
 {
@@ -3686,55 +4220,222 @@ static void delete_tree(thread_db* tdbb,
  *
  **************************************/
 
-	SET_TDBB(tdbb);
-	WIN window(next.getPageSpaceID(), -1);
-	window.win_flags = WIN_large_scan;
-	window.win_scans = 1;
+	SET_TDBB(tdbb);
+	WIN window(next.getPageSpaceID(), -1);
+	window.win_flags = WIN_large_scan;
+	window.win_scans = 1;
+
+	ULONG down = next.getPageNum();
+	// Delete the index tree from the top down.
+	while (next.getPageNum())
+	{
+		window.win_page = next;
+		btree_page* page = (btree_page*) CCH_FETCH(tdbb, &window, LCK_write, 0);
+
+		// do a little defensive programming--if any of these conditions
+		// are true we have a damaged pointer, so just stop deleting. At
+		// the same time, allow updates of indexes with id > 255 even though
+		// the page header uses a byte for its index id.  This requires relaxing
+		// the check slightly introducing a risk that we'll pick up a page belonging
+		// to some other index that is ours +/- (256*n).  On the whole, unlikely.
+		if (page->btr_header.pag_type != pag_index ||
+			page->btr_id != (UCHAR)(idx_id % 256) || page->btr_relation != rel_id)
+		{
+			CCH_RELEASE(tdbb, &window);
+			return;
+		}
+
+		// if we are at the beginning of a non-leaf level, position
+		// "down" to the beginning of the next level down
+		if (next.getPageNum() == down)
+		{
+			if (page->btr_level)
+			{
+				UCHAR* pointer = page->btr_nodes + page->btr_jump_size;
+				IndexNode pageNode;
+				pageNode.readNode(pointer, false);
+				down = pageNode.pageNumber;
+			}
+			else
+				down = 0;
+		}
+
+		// go through all the sibling pages on this level and release them
+		next = page->btr_sibling;
+		CCH_RELEASE_TAIL(tdbb, &window);
+		PAG_release_page(tdbb, window.win_page, prior);
+		prior = window.win_page;
+
+		// if we are at end of level, go down to the next level
+		if (!next.getPageNum())
+			next = down;
+	}
+}
+
+
+static void evaluate_ranges(thread_db* tdbb, const IndexRetrieval* retrieval,
+							RecordBitmap** bitmap, RecordBitmap* bitmap_and)
+{
+/**************************************
+ *
+ *	e v a l u a t e _ r a n g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Scan the block range summaries and return a bitmap of
+ *	all records stored on the matching ranges of data pages.
+ *	The caller is expected to recheck the records.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+	Database* const dbb = tdbb->getDatabase();
+	MemoryPool& pool = *tdbb->getDefaultPool();
+
+	jrd_rel* const relation = retrieval->irb_relation;
+	RelationPages* const relPages = relation->getPages(tdbb);
+	WIN window(relPages->rel_pg_space_id, -1);
+
+	temporary_key lowerKey, upperKey;
+	lowerKey.key_flags = 0;
+	lowerKey.key_length = 0;
+	upperKey.key_flags = 0;
+	upperKey.key_length = 0;
+
+	AutoPtr<IndexScanListIterator> iterator =
+		retrieval->irb_list ? FB_NEW_POOL(pool) IndexScanListIterator(tdbb, retrieval) : nullptr;
+
+	temporary_key* lower = &lowerKey;
+	temporary_key* upper = &upperKey;
+	USHORT forceInclFlag = 0;
+
+	if (!BTR_make_bounds(tdbb, retrieval, iterator, lower, upper, forceInclFlag))
+		return;
+
+	// Collect all the lookup key pairs, the summaries are read just once.
+	// Every key is stored as its USHORT length followed by the key bytes.
+
+	HalfStaticArray<UCHAR, 1024> keys(pool);
+
+	do
+	{
+		for (const temporary_key *l = lower, *u = upper; l && u; l = l->key_next.get(), u = u->key_next.get())
+		{
+			keys.add((const UCHAR*) &l->key_length, sizeof(USHORT));
+			keys.add(l->key_data, l->key_length);
+			keys.add((const UCHAR*) &u->key_length, sizeof(USHORT));
+			keys.add(u->key_data, u->key_length);
+		}
+	} while (iterator && iterator->getNext(tdbb, lower, upper));
+
+	window.win_page = relPages->rel_index_root;
+	index_root_page* const root = (index_root_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_root);
+
+	index_desc idx;
+	if (!BTR_description(tdbb, relation, root, &idx, retrieval->irb_index))
+	{
+		CCH_RELEASE(tdbb, &window);
+		IBERROR(260);	// msg 260 index unexpectedly deleted
+	}
+
+	const range_page* page =
+		(range_page*) CCH_HANDOFF(tdbb, &window, idx.idx_root, LCK_read, pag_range);
+
+	const USHORT maxLength = page->rng_key_length;
+	const ULONG perPage = rangesPerPage(dbb, maxLength);
+	const FB_SIZE_T summaryLength = rangeSummaryLength(maxLength);
+	const ULONG directorySize = rangeDirectorySize(dbb);
+
+	HalfStaticArray<ULONG, 64> pages(pool);
+	pages.assign(page->rng_data, MIN(page->rng_count, directorySize));
 
-	ULONG down = next.getPageNum();
-	// Delete the index tree from the top down.
-	while (next.getPageNum())
+	CCH_RELEASE(tdbb, &window);
+
+	// Find the runs of the matching ranges, they are visited in ascending order
+
+	HalfStaticArray<FB_UINT64, 16> runs(pool);
+	FB_UINT64 range = 0;
+
+	for (const ULONG* iter = pages.begin(); iter != pages.end(); ++iter, range += perPage)
 	{
-		window.win_page = next;
-		btree_page* page = (btree_page*) CCH_FETCH(tdbb, &window, LCK_write, 0);
+		if (!*iter)
+			continue;
 
-		// do a little defensive programming--if any of these conditions
-		// are true we have a damaged pointer, so just stop deleting. At
-		// the same time, allow updates of indexes with id > 255 even though
-		// the page header uses a byte for its index id.  This requires relaxing
-		// the check slightly introducing a risk that we'll pick up a page belonging
-		// to some other index that is ours +/- (256*n).  On the whole, unlikely.
-		if (page->btr_header.pag_type != pag_index ||
-			page->btr_id != (UCHAR)(idx_id % 256) || page->btr_relation != rel_id)
-		{
-			CCH_RELEASE(tdbb, &window);
-			return;
-		}
+		window.win_page = *iter;
+		page = (range_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_range);
 
-		// if we are at the beginning of a non-leaf level, position
-		// "down" to the beginning of the next level down
-		if (next.getPageNum() == down)
+		const UCHAR* p = (UCHAR*) page->rng_data;
+
+		for (ULONG i = 0; i < perPage; i++, p += summaryLength)
 		{
-			if (page->btr_level)
+			const range_summary* const rns = (range_summary*) p;
+
+			if (rns->rns_min_length == rns_empty)
+				continue;
+
+			const UCHAR* const minKey = rns->rns_data;
+			const UCHAR* const maxKey = rns->rns_data + maxLength;
+
+			for (const UCHAR* k = keys.begin(); k < keys.end();)
 			{
-				UCHAR* pointer = page->btr_nodes + page->btr_jump_size;
-				IndexNode pageNode;
-				pageNode.readNode(pointer, false);
-				down = pageNode.pageNumber;
+				USHORT lowerLength, upperLength;
+
+				memcpy(&lowerLength, k, sizeof(USHORT));
+				const UCHAR* const lowerData = k + sizeof(USHORT);
+				k = lowerData + lowerLength;
+
+				memcpy(&upperLength, k, sizeof(USHORT));
+				const UCHAR* const upperData = k + sizeof(USHORT);
+				k = upperData + upperLength;
+
+				if (retrieval->irb_lower_count &&
+					compareRangeKeys(maxKey, rns->rns_max_length, lowerData, lowerLength) < 0)
+				{
+					continue;
+				}
+
+				// The upper bound may be a partial key, so compare just its length of the lowest key
+
+				if (retrieval->irb_upper_count &&
+					compareRangeKeys(minKey, MIN(rns->rns_min_length, upperLength),
+						upperData, upperLength) > 0)
+				{
+					continue;
+				}
+
+				// Start a new run or extend the last one
+
+				if (runs.hasData() && runs.back() == range + i)
+					runs.back()++;
+				else
+				{
+					runs.add(range + i);
+					runs.add(range + i + 1);
+				}
+
+				break;
 			}
-			else
-				down = 0;
 		}
 
-		// go through all the sibling pages on this level and release them
-		next = page->btr_sibling;
-		CCH_RELEASE_TAIL(tdbb, &window);
-		PAG_release_page(tdbb, window.win_page, prior);
-		prior = window.win_page;
+		CCH_RELEASE(tdbb, &window);
+	}
 
-		// if we are at end of level, go down to the next level
-		if (!next.getPageNum())
-			next = down;
+	// Expand the runs to the records stored on their data pages
+
+	for (FB_SIZE_T i = 0; i < runs.getCount(); i += 2)
+	{
+		DPM_range_records(tdbb, relation, (ULONG) (runs[i] * RANGE_DATA_PAGES),
+			(ULONG) ((runs[i + 1] - runs[i]) * RANGE_DATA_PAGES), bitmap, bitmap_and);
+	}
+
+	// Data pages beyond the directory capacity are not summarized
+
+	const FB_UINT64 unsummarized = (FB_UINT64) directorySize * perPage * RANGE_DATA_PAGES;
+
+	if (unsummarized < MAX_ULONG)
+	{
+		DPM_range_records(tdbb, relation, (ULONG) unsummarized,
+			MAX_ULONG - (ULONG) unsummarized, bitmap, bitmap_and);
 	}
 }
 
@@ -4633,6 +5334,11 @@ static UCHAR* find_node_start_point(btree_page* bucket, temporary_key* key,
 			const UCHAR* const nodeEnd = q + node.length;
 			if (descending)
 			{
+				// Skip the equal bytes, the loop below stops at the first difference
+				const USHORT same = matchLength(p, q, MIN(key_end - p, nodeEnd - q));
+				p += same;
+				q += same;
+
 				while (true)
 				{
 					if (q == nodeEnd)
@@ -4660,6 +5366,11 @@ static UCHAR* find_node_start_point(btree_page* bucket, temporary_key* key,
 			else if (node.length > 0 || firstPass)
 			{
 				firstPass = false;
+
+				const USHORT same = matchLength(p, q, MIN(key_end - p, nodeEnd - q));
+				p += same;
+				q += same;
+
 				while (true)
 				{
 					if (p == key_end)
@@ -4767,6 +5478,11 @@ static UCHAR* find_area_start_point(btree_page* bucket, const temporary_key* key
 
 		if ((jumpNode.prefix <= testPrefix) && descending)
 		{
+			// Skip the equal bytes, the loop below stops at the first difference
+			const USHORT same = matchLength(keyPointer, q, MIN(keyEnd - keyPointer, nodeEnd - q));
+			keyPointer += same;
+			q += same;
+
 			while (true)
 			{
 				if (q == nodeEnd)
@@ -4846,6 +5562,10 @@ static UCHAR* find_area_start_point(btree_page* bucket, const temporary_key* key
 		}
 		else if (jumpNode.prefix <= testPrefix)
 		{
+			const USHORT same = matchLength(keyPointer, q, MIN(keyEnd - keyPointer, nodeEnd - q));
+			keyPointer += same;
+			q += same;
+
 			while (true)
 			{
 				if (keyPointer == keyEnd)
@@ -5026,6 +5746,11 @@ static ULONG find_page(btree_page* bucket, const temporary_key* key,
 		const UCHAR* const nodeEnd = q + node.length; // pointer on end of processing node
 		if (node.prefix == prefix)
 		{
+			// Skip the equal bytes, the loops below stop at the first difference
+			const USHORT same = matchLength(p, q, MIN(keyEnd - p, nodeEnd - q));
+			p += same;
+			q += same;
+
 			if (descending)
 			{
 				// Descending indexes
@@ -5756,6 +6481,86 @@ static void generate_jump_nodes(thread_db* tdbb, btree_page* page,
 }
 
 
+static ULONG insert_last_leaf(thread_db* tdbb,
+							  WIN* root_window,
+							  WIN* window,
+							  index_insertion* insertion,
+							  temporary_key* new_key,
+							  RecordNumber* new_record_number)
+{
+/**************************************
+ *
+ *	i n s e r t _ l a s t _ l e a f
+ *
+ **************************************
+ *
+ * Functional description
+ *	Insert a node directly into the rightmost leaf page of
+ *	index if the key goes after its first node. The page is
+ *	known from the previous insertion into this index.
+ *	Return NO_VALUE_PAGE with index root page still fetched
+ *	if there is no such page, otherwise return the same
+ *	as insert_node.
+ *
+ **************************************/
+	const index_desc* const idx = insertion->iib_descriptor;
+	jrd_rel* const relation = insertion->iib_relation;
+	RelationPages* const relPages = relation->getPages(tdbb);
+
+	const ULONG page = relPages->getLastLeaf(idx->idx_id, insertion->iib_root_incarnation);
+	if (!page || page == idx->idx_root)
+		return NO_VALUE_PAGE;
+
+	// The page could be released or reused since the last insertion,
+	// so check it belongs to our index and is still the rightmost leaf.
+	// Index root page incarnation guarantees the index was not re-created.
+
+	window->win_page = page;
+	btree_page* const bucket = (btree_page*) CCH_FETCH(tdbb, window, LCK_write, pag_undefined);
+
+	bool valid = (bucket->btr_header.pag_type == pag_index) &&
+		!(bucket->btr_header.pag_flags & btr_released) &&
+		bucket->btr_relation == relation->rel_id &&
+		bucket->btr_id == (UCHAR) (idx->idx_id % 256) &&
+		bucket->btr_level == 0 && !bucket->btr_sibling;
+
+	if (valid)
+	{
+		// Nodes with the key equal to the first one could be at the left page too
+
+		const temporary_key* const key = insertion->iib_key;
+
+		IndexNode node;
+		node.readNode(bucket->btr_nodes + bucket->btr_jump_size, true);
+		fb_assert(!node.prefix);
+
+		const USHORT length = MIN(key->key_length, node.length);
+		const int cmp = memcmp(key->key_data, node.data, length);
+
+		valid = !node.isEndLevel && (cmp > 0 || (!cmp && key->key_length > node.length));
+	}
+
+	if (!valid)
+	{
+		CCH_RELEASE(tdbb, window);
+		relPages->setLastLeaf(idx->idx_id, 0, 0);
+		return NO_VALUE_PAGE;
+	}
+
+	CCH_RELEASE(tdbb, root_window);
+
+	const ULONG split = insert_node(tdbb, window, insertion, new_key, new_record_number, NULL, NULL);
+
+	if (split == NO_VALUE_PAGE)
+	{
+		CCH_RELEASE(tdbb, window);
+		BUGCHECK(204);	// msg 204 index inconsistent
+	}
+
+	return split;
+}
+
+
 static ULONG insert_node(thread_db* tdbb,
 						 WIN* window,
 						 index_insertion* insertion,
@@ -6075,6 +6880,13 @@ static ULONG insert_node(thread_db* tdbb,
 		bucket->btr_prefix_total = newBucket->btr_prefix_total;
 		bucket->btr_length = newBucket->btr_length + jumpersNewSize - jumpersOriginalSize;
 
+		// Remember the rightmost leaf page for the next insertion into its end
+		if (leafPage && endOfPage && !bucket->btr_sibling)
+		{
+			insertion->iib_relation->getPages(tdbb)->setLastLeaf(idx->idx_id,
+				insertion->iib_root_incarnation, window->win_page.getPageNum());
+		}
+
 		CCH_RELEASE(tdbb, window);
 
 		jumpNodes->clear();
@@ -6344,6 +7156,13 @@ static ULONG insert_node(thread_db* tdbb,
 	if (original_page)
 		*original_page = window->win_page.getPageNum();
 
+	// The split page is the new rightmost leaf page
+	if (leafPage && endOfPage && !right_sibling)
+	{
+		insertion->iib_relation->getPages(tdbb)->setLastLeaf(idx->idx_id,
+			insertion->iib_root_incarnation, split_page);
+	}
+
 	// now we need to go to the right sibling page and update its
 	// left sibling pointer to point to the newly split page
 	if (right_sibling)
@@ -6382,6 +7201,98 @@ static ULONG insert_node(thread_db* tdbb,
 }
 
 
+static ULONG load_ranges(thread_db* tdbb, IndexCreation& creation, SelectivityList& selectivity)
+{
+/**************************************
+ *
+ *	l o a d _ r a n g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Build a block range index from the sorted keys.
+ *	Return the number of the directory page.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	jrd_rel* const relation = creation.relation;
+	index_desc* const idx = creation.index;
+	const USHORT key_length = creation.key_length;
+
+	WIN window(relation->getPages(tdbb)->rel_pg_space_id, -1);
+
+	range_page* const directory = (range_page*) DPM_allocate(tdbb, &window);
+	directory->rng_header.pag_type = pag_range;
+	directory->rng_header.pag_flags = rng_directory;
+	directory->rng_relation = relation->rel_id;
+	directory->rng_id = idx->idx_id;
+	directory->rng_key_length = BTR_key_length(tdbb, relation, idx);
+
+	const ULONG directoryPage = window.win_page.getPageNum();
+	CCH_RELEASE(tdbb, &window);
+
+	FB_UINT64 count = 0;
+	FB_UINT64 duplicates = 0;
+
+	temporary_key prior;
+	prior.key_length = 0;
+	prior.key_flags = 0;
+
+	try
+	{
+		while (true)
+		{
+			UCHAR* record;
+			creation.sort->get(tdbb, reinterpret_cast<ULONG**>(&record));
+
+			if (!record)
+				break;
+
+			const index_sort_record* const isr = (index_sort_record*) (record + key_length);
+			record += creation.nullIndLen;
+
+			// The sort output is ordered by key, so only the neighbours can be equal
+
+			if (count && prior.key_length == isr->isr_key_length &&
+				!memcmp(prior.key_data, record, isr->isr_key_length))
+			{
+				duplicates++;
+			}
+			else
+			{
+				prior.key_length = isr->isr_key_length;
+				memcpy(prior.key_data, record, isr->isr_key_length);
+			}
+
+			count++;
+
+			update_range(tdbb, relation, directoryPage, RecordNumber(isr->isr_record_number),
+				record, isr->isr_key_length);
+		}
+
+		if (!relation->isTemporary())
+			CCH_flush(tdbb, FLUSH_ALL, 0);
+	}
+	catch (const Exception&)
+	{
+		delete_ranges(tdbb, relation->rel_id, idx->idx_id,
+					  PageNumber(window.win_page.getPageSpaceID(), directoryPage),
+					  PageNumber(window.win_page.getPageSpaceID(), 0));
+		throw;
+	}
+
+	// The summaries cannot tell the values apart, keep the key
+	// selectivity for the optimizer to compare with other indices
+
+	selectivity.grow(idx->idx_count);
+	for (ULONG i = 0; i < idx->idx_count; i++)
+		selectivity[i] = (float) (count ? (1.0 / (float) (count - duplicates)) : 0.0);
+
+	return directoryPage;
+}
+
+
 static INT64_KEY make_int64_key(SINT64 q, SSHORT scale)
 {
 /**************************************
@@ -6952,6 +7863,146 @@ static bool scan(thread_db* tdbb, UCHAR* pointer, RecordBitmap** bitmap, RecordB
 }
 
 
+static void update_range(thread_db* tdbb, jrd_rel* relation, ULONG directoryPage,
+						 RecordNumber number, const UCHAR* key, USHORT keyLength)
+{
+/**************************************
+ *
+ *	u p d a t e _ r a n g e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Widen the summary of the block range containing the given
+ *	record so that it covers the key. The summary page is
+ *	allocated on the first key stored into its ranges.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+	Database* const dbb = tdbb->getDatabase();
+
+	RelationPages* const relPages = relation->getPages(tdbb);
+	WIN window(relPages->rel_pg_space_id, directoryPage);
+
+	range_page* directory = (range_page*) CCH_FETCH(tdbb, &window, LCK_read, pag_range);
+
+	const USHORT maxLength = directory->rng_key_length;
+	fb_assert(keyLength <= maxLength);
+
+	const ULONG perPage = rangesPerPage(dbb, maxLength);
+	const FB_UINT64 range = number.getValue() / dbb->dbb_max_records / RANGE_DATA_PAGES;
+	const FB_UINT64 sequence = range / perPage;
+
+	// Ranges which do not fit the directory are never summarized,
+	// the retrieval treats them as always matching
+
+	if (sequence >= rangeDirectorySize(dbb) || keyLength > maxLength)
+	{
+		CCH_RELEASE(tdbb, &window);
+		return;
+	}
+
+	ULONG summaryPage = directory->rng_data[sequence];
+
+	if (!summaryPage)
+	{
+		// Upgrade to the write lock and check again, someone else could
+		// have allocated the summary page in the meantime
+
+		const USHORT relationId = directory->rng_relation;
+		const USHORT indexId = directory->rng_id;
+
+		CCH_RELEASE(tdbb, &window);
+		directory = (range_page*) CCH_FETCH(tdbb, &window, LCK_write, pag_range);
+
+		if (!(summaryPage = directory->rng_data[sequence]))
+		{
+			WIN newWindow(relPages->rel_pg_space_id, -1);
+			range_page* summary = (range_page*) DPM_allocate(tdbb, &newWindow);
+
+			summary->rng_header.pag_type = pag_range;
+			summary->rng_relation = relationId;
+			summary->rng_id = indexId;
+			summary->rng_sequence = (ULONG) sequence;
+			summary->rng_key_length = maxLength;
+
+			const FB_SIZE_T summaryLength = rangeSummaryLength(maxLength);
+			UCHAR* p = (UCHAR*) summary->rng_data;
+
+			for (ULONG i = 0; i < perPage; i++, p += summaryLength)
+				((range_summary*) p)->rns_min_length = rns_empty;
+
+			summaryPage = newWindow.win_page.getPageNum();
+			CCH_RELEASE(tdbb, &newWindow);
+
+			// Make sure the summary page is written before the directory points to it
+
+			CCH_precedence(tdbb, &window, summaryPage);
+			CCH_MARK(tdbb, &window);
+			directory->rng_data[sequence] = summaryPage;
+
+			if (sequence >= directory->rng_count)
+				directory->rng_count = (USHORT) (sequence + 1);
+		}
+	}
+
+	const FB_SIZE_T offset = (range % perPage) * rangeSummaryLength(maxLength);
+
+	// Most keys fall into the already summarized bounds, so check them under
+	// the read lock and upgrade it only when the summary has to be widened
+
+	range_page* summary =
+		(range_page*) CCH_HANDOFF(tdbb, &window, summaryPage, LCK_read, pag_range);
+
+	range_summary* rns = (range_summary*) ((UCHAR*) summary->rng_data + offset);
+
+	if (rns->rns_min_length != rns_empty &&
+		compareRangeKeys(key, keyLength, rns->rns_data, rns->rns_min_length) >= 0 &&
+		compareRangeKeys(key, keyLength, rns->rns_data + maxLength, rns->rns_max_length) <= 0)
+	{
+		CCH_RELEASE(tdbb, &window);
+		return;
+	}
+
+	CCH_RELEASE(tdbb, &window);
+	summary = (range_page*) CCH_FETCH(tdbb, &window, LCK_write, pag_range);
+	rns = (range_summary*) ((UCHAR*) summary->rng_data + offset);
+
+	UCHAR* const minKey = rns->rns_data;
+	UCHAR* const maxKey = rns->rns_data + maxLength;
+
+	if (rns->rns_min_length == rns_empty)
+	{
+		CCH_MARK(tdbb, &window);
+		memcpy(minKey, key, keyLength);
+		memcpy(maxKey, key, keyLength);
+		rns->rns_min_length = rns->rns_max_length = keyLength;
+	}
+	else
+	{
+		const bool lower = compareRangeKeys(key, keyLength, minKey, rns->rns_min_length) < 0;
+		const bool higher = compareRangeKeys(key, keyLength, maxKey, rns->rns_max_length) > 0;
+
+		if (lower || higher)
+			CCH_MARK(tdbb, &window);
+
+		if (lower)
+		{
+			memcpy(minKey, key, keyLength);
+			rns->rns_min_length = keyLength;
+		}
+
+		if (higher)
+		{
+			memcpy(maxKey, key, keyLength);
+			rns->rns_max_length = keyLength;
+		}
+	}
+
+	CCH_RELEASE(tdbb, &window);
+}
+
+
 void update_selectivity(index_root_page* root, USHORT id, const SelectivityList& selectivity)
 {
 /**************************************
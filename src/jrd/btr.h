@@ -119,6 +119,7 @@ const int idx_foreign		= 8;
 const int idx_primary		= 16;
 const int idx_expression	= 32;
 const int idx_condition		= 64;
+const int idx_block_range	= 128;	// min/max summaries of data page runs instead of a b-tree
 
 // these flags are for idx_runtime_flags
 
@@ -141,6 +142,7 @@ struct index_insertion
 	jrd_tra*	iib_transaction;	// insertion transaction
 	BtrPageGCLock*	iib_dont_gc_lock;	// lock to prevent removal of splitted page
 	UCHAR	iib_btr_level;			// target level to propagate split page to
+	SLONG	iib_root_incarnation;	// incarnation of index root page, set by BTR_insert
 };
 
 
@@ -238,6 +240,7 @@ const int irb_exclude_upper	= 64;			// exclude upper bound keys while scanning i
 const int irb_multi_starting	= 128;		// Use INTL_KEY_MULTI_STARTING
 const int irb_root_list_scan	= 256;		// Locate list items from the root
 const int irb_unique	= 512;				// Unique match (currently used only for plan output)
+const int irb_skip_scan	= 1024;				// Leading segment is not bound, probe every its distinct value
 
 // Force include flags - always include appropriate key while scanning index
 const int irb_force_lower	= irb_exclude_lower;
@@ -305,6 +308,57 @@ struct IndexCreation
 	Firebird::AtomicCounter duplicates;
 };
 
+// Keys of non-unique indices stored by bulk inserts. They are collected
+// per index and applied to the b-tree in key order, so leaf pages are
+// visited sequentially instead of randomly.
+
+class BulkIndexKeys
+{
+	struct Buffer
+	{
+		jrd_rel* relation;
+		USHORT id;
+		USHORT keyLength;		// length of key part of the sort record
+		USHORT nullIndLen;		// see IDX_create_index
+		ULONG size;				// bytes put into the sort
+		Sort* sort;
+	};
+
+	struct Relation
+	{
+		jrd_rel* relation;
+		bool deferrable;		// see isDeferrable()
+	};
+
+public:
+	explicit BulkIndexKeys(MemoryPool& pool)
+		: m_buffers(pool), m_relations(pool), m_full(false)
+	{}
+
+	~BulkIndexKeys();
+
+	bool isEmpty() const
+	{
+		return m_buffers.isEmpty();
+	}
+
+	bool isFull() const
+	{
+		return m_full;
+	}
+
+	bool isDeferrable(thread_db*, jrd_rel*);
+	bool put(thread_db*, jrd_tra*, jrd_rel*, index_desc*, const temporary_key*, RecordNumber);
+	void flush(thread_db*, jrd_tra*);
+
+private:
+	void apply(thread_db*, jrd_tra*, const Buffer&);
+
+	Firebird::HalfStaticArray<Buffer, 8> m_buffers;
+	Firebird::HalfStaticArray<Relation, 4> m_relations;
+	bool m_full;
+};
+
 // Class used to report any index related errors
 
 class IndexErrorContext
@@ -529,6 +583,24 @@ private:
 	USHORT m_segno = MAX_USHORT;
 };
 
+class IndexSkipScanIterator
+{
+public:
+	IndexSkipScanIterator(thread_db* tdbb, const IndexRetrieval* retrieval,
+						  const temporary_key* lower, const temporary_key* upper);
+
+	bool getNext(thread_db* tdbb, temporary_key* lower, temporary_key* upper);
+
+private:
+	void makeKey(thread_db* tdbb, const temporary_key* suffix, temporary_key* key) const;
+
+	const IndexRetrieval* const m_retrieval;
+	temporary_key m_lower;		// bounds without the leading segment
+	temporary_key m_upper;
+	temporary_key m_prefix;		// current value of the leading segment
+	bool m_first = true;
+};
+
 } //namespace Jrd
 
 #endif // JRD_BTR_H
@@ -29,6 +29,7 @@
 #include "firebird.h"
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <stdlib.h>
 #include "../jrd/jrd.h"
 #include "../jrd/que.h"
@@ -62,6 +63,7 @@
 #include "../common/classes/MsgPrint.h"
 #include "../jrd/CryptoManager.h"
 #include "../common/utils_proto.h"
+#include "../common/os/os_utils.h"
 #include "../jrd/PageToBufferMap.h"
 
 #ifndef CDS_UNAVAILABLE
@@ -137,9 +139,11 @@ static void prefetch_prologue(Prefetch*, SLONG *);
 static void cacheBuffer(Attachment* att, BufferDesc* bdb);
 static void check_precedence(thread_db*, WIN*, PageNumber);
 static void clear_precedence(thread_db*, BufferDesc*);
+class WriteBatch;
+
 static void down_grade(thread_db*, BufferDesc*, int high = 0);
 static bool expand_buffers(thread_db*, ULONG);
-static BufferDesc* get_buffer(thread_db*, const PageNumber, SyncType, int);
+static BufferDesc* get_buffer(thread_db*, const PageNumber, SyncType, int, bool);
 static int get_related(BufferDesc*, PagesArray&, int, const ULONG);
 static ULONG get_prec_walk_mark(BufferControl*);
 static LockState lock_buffer(thread_db*, BufferDesc*, const SSHORT, const SCHAR);
@@ -148,13 +152,20 @@ static void page_validation_error(thread_db*, win*, SSHORT);
 static void purgePrecedence(BufferControl*, BufferDesc*);
 static SSHORT related(BufferDesc*, const BufferDesc*, SSHORT, const ULONG);
 static int write_buffer(thread_db*, BufferDesc*, const PageNumber, const bool, FbStatusVector* const,
-	const bool);
-static bool write_page(thread_db*, BufferDesc*, FbStatusVector* const, const bool);
+	const bool, WriteBatch* = nullptr);
+static bool write_page(thread_db*, BufferDesc*, FbStatusVector* const, const bool, WriteBatch* = nullptr);
+static void write_done(thread_db*, BufferDesc*, const bool);
 static bool set_diff_page(thread_db*, BufferDesc*);
 static void clear_dirty_flag_and_nbak_state(thread_db*, BufferDesc*);
 
 static BufferDesc* get_dirty_buffer(thread_db*);
 
+static void prewarm_load(thread_db*, Firebird::Array<ULONG>&);
+static FB_SIZE_T prewarm_pages(thread_db*, BufferControl*, const Firebird::Array<ULONG>&, FB_SIZE_T);
+static void prewarm_save(thread_db*, BufferControl*);
+
+static bool read_ahead_pages(thread_db*, BufferControl*);
+
 
 static inline void insertDirty(BufferControl* bcb, BufferDesc* bdb)
 {
@@ -195,9 +206,22 @@ static void flushPages(thread_db* tdbb, USHORT flush_flag, BufferDesc** begin, F
 
 static void recentlyUsed(BufferDesc* bdb);
 static void requeueRecentlyUsed(BufferControl* bcb);
+static bool hasRecentlyUsed(const BufferControl* bcb);
 
 
 const ULONG MIN_BUFFER_SEGMENT = 65536;
+const ULONG MAX_WRITE_BATCH = 1024 * 1024;	// bytes written by single vectored I/O in flushPages()
+
+// Saved list of cached pages, see CachePrewarm setting
+
+const char* const PREWARM_SUFFIX = ".cache";
+const ULONG PREWARM_VERSION = 1;
+const FB_SIZE_T PREWARM_CHUNK = 64;			// pages read by cache writer at once
+const time_t PREWARM_SAVE_INTERVAL = 300;	// seconds
+
+// Pages queued to be read ahead by cache writer, see CCH_read_ahead
+
+const FB_SIZE_T READ_AHEAD_QUEUE_MAX = 4 * READ_AHEAD_MAX_PAGES;
 
 // Given pointer a field in the block, find the block
 
@@ -718,7 +742,7 @@ pag* CCH_fake(thread_db* tdbb, WIN* window, int wait)
 	if (dbb->dbb_ast_flags & DBB_get_shadows)
 		SDW_get_shadows(tdbb);
 
-	BufferDesc* bdb = get_buffer(tdbb, window->win_page, SYNC_EXCLUSIVE, wait);
+	BufferDesc* bdb = get_buffer(tdbb, window->win_page, SYNC_EXCLUSIVE, wait, false);
 	if (!bdb)
 		return NULL;			// latch timeout occurred
 
@@ -870,10 +894,14 @@ LockState CCH_fetch_lock(thread_db* tdbb, WIN* window, int lock_type, int wait,
 	if (dbb->dbb_ast_flags & DBB_get_shadows)
 		SDW_get_shadows(tdbb);
 
-	// Look for the page in the cache.
+	// Look for the page in the cache. A page read by the only large scan of
+	// a relation is not going to be needed again soon, so it shouldn't push
+	// the hot pages out of the LRU que.
+
+	const bool lowPriority = (window->win_flags & WIN_large_scan) && window->win_scans <= 1;
 
 	BufferDesc* bdb = get_buffer(tdbb, window->win_page,
-		((lock_type >= LCK_write) ? SYNC_EXCLUSIVE : SYNC_SHARED), wait);
+		((lock_type >= LCK_write) ? SYNC_EXCLUSIVE : SYNC_SHARED), wait, lowPriority);
 
 	if (wait != 1 && bdb == 0)
 		return lsLatchTimeout; // latch timeout
@@ -1929,6 +1957,106 @@ bool CCH_prefetch_pages(thread_db* tdbb)
 #endif // CACHE_READER
 
 
+void CCH_read_ahead(thread_db* tdbb, USHORT pageSpaceId, const ULONG* pages, USHORT count)
+{
+/**************************************
+ *
+ *	C C H _ r e a d _ a h e a d
+ *
+ **************************************
+ *
+ * Functional description
+ *	Given a vector of pages which are going to be fetched soon,
+ *	ask the OS to start reading the ones missing in the cache.
+ *	Adjacent pages are requested as a single run.
+ *
+ *	If the file system cache is not used there is nothing to ask
+ *	the OS for. Then the missing pages are queued to be read into
+ *	the page cache by the cache writer, if it's running. The caller
+ *	doesn't wait for the reads in either case.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+	Database* const dbb = tdbb->getDatabase();
+	BufferControl* const bcb = dbb->dbb_bcb;
+
+	if (!count)
+		return;
+
+	// While nbackup is active some pages are read from the difference file
+
+	if (dbb->dbb_backup_manager->getState() != Ods::hdr_nbak_normal)
+		return;
+
+	PageSpace* const pageSpace = dbb->dbb_page_manager.findPageSpace(pageSpaceId);
+	if (!pageSpace || !pageSpace->file)
+		return;
+
+	const bool direct = (pageSpace->file->fil_flags & FIL_no_fs_cache);
+
+	if (direct && (!(bcb->bcb_flags & BCB_cache_writer) || PageSpace::isTemporary(pageSpaceId)))
+		return;
+
+	HalfStaticArray<ULONG, READ_AHEAD_MAX_PAGES> missing;
+	ULONG runStart = 0, runLength = 0;
+
+	for (const ULONG* const end = pages + count; pages < end; pages++)
+	{
+		const ULONG page = *pages;
+
+		bool cached;
+		{
+#ifndef HASH_USE_CDS_LIST
+			SyncLockGuard bcbSync(&bcb->bcb_syncObject, SYNC_SHARED, FB_FUNCTION);
+#endif
+			cached = bcb->bcb_hashTable->find(PageNumber(pageSpaceId, page)) != nullptr;
+		}
+
+		if (cached)
+			continue;
+
+		if (direct)
+		{
+			missing.add(page);
+			continue;
+		}
+
+		if (runLength && page == runStart + runLength)
+		{
+			runLength++;
+			continue;
+		}
+
+		if (runLength)
+			PIO_prefetch(tdbb, pageSpace->file, runStart, runLength);
+
+		runStart = page;
+		runLength = 1;
+	}
+
+	if (runLength)
+		PIO_prefetch(tdbb, pageSpace->file, runStart, runLength);
+
+	if (missing.isEmpty())
+		return;
+
+	{ // scope
+		MutexLockGuard guard(bcb->bcb_read_ahead_mutex, FB_FUNCTION);
+
+		// Read ahead is just a hint, pages not fitting the queue are not read
+
+		const FB_SIZE_T queued = bcb->bcb_read_ahead.getCount();
+		const FB_SIZE_T room = (queued < READ_AHEAD_QUEUE_MAX) ? READ_AHEAD_QUEUE_MAX - queued : 0;
+
+		for (FB_SIZE_T i = 0; i < missing.getCount() && i < room; i++)
+			bcb->bcb_read_ahead.add(PageNumber(pageSpaceId, missing[i]));
+	}
+
+	if (!(bcb->bcb_flags & BCB_writer_active))
+		bcb->bcb_writer_sem.release();
+}
+
+
 bool set_diff_page(thread_db* tdbb, BufferDesc* bdb)
 {
 	Database* const dbb = tdbb->getDatabase();
@@ -2774,23 +2902,182 @@ extern "C" {
 } // extern C
 
 
+// Run of adjacent dirty pages collected by flushPages() to be written by
+// single vectored I/O. Batched pages stay latched and I/O locked, and their
+// precedence is not cleared, until the whole batch is written. Once written,
+// the batch accepts no more pages, its latches are released by flushPages().
+
+class WriteBatch
+{
+public:
+	WriteBatch(MemoryPool& pool, Database* dbb)
+		: m_bdbs(pool), m_pages(pool), m_copies(pool),
+		  m_pageSize(dbb->dbb_page_size),
+		  m_ioBlockSize(dbb->getIOBlockSize()),
+		  m_maxCount(MAX(MAX_WRITE_BATCH / dbb->dbb_page_size, 1)),
+		  m_written(false), m_result(true)
+	{ }
+
+	bool isEmpty() const
+	{
+		return m_bdbs.isEmpty();
+	}
+
+	bool contains(const BufferDesc* bdb) const
+	{
+		return m_bdbs.hasData() && m_bdbs.back() == bdb;
+	}
+
+	// Check if the page may continue the batch
+
+	bool fits(const BufferDesc* bdb) const
+	{
+		if (m_written)
+			return false;
+
+		if (m_bdbs.isEmpty())
+			return true;
+
+		const PageNumber& last = m_bdbs.back()->bdb_page;
+
+		return m_bdbs.getCount() < m_maxCount &&
+			bdb->bdb_page.getPageSpaceID() == last.getPageSpaceID() &&
+			bdb->bdb_page.getPageNum() == last.getPageNum() + 1;
+	}
+
+	void add(BufferDesc* bdb, Ods::pag* page)
+	{
+		// Crypto manager may call us again for the same page
+
+		if (contains(bdb))
+		{
+			m_bdbs.pop();
+			m_pages.pop();
+		}
+
+		fb_assert(fits(bdb));
+
+		// Page image encrypted into temporary buffer must be copied,
+		// otherwise the latched page buffer is written directly
+
+		if (page != bdb->bdb_buffer)
+		{
+			if (m_copies.isEmpty())
+				m_copies.getBuffer(m_maxCount * m_pageSize + m_ioBlockSize);
+
+			UCHAR* const copy = FB_ALIGN(m_copies.begin(), m_ioBlockSize) +
+				m_bdbs.getCount() * m_pageSize;
+
+			memcpy(copy, page, m_pageSize);
+			page = (Ods::pag*) copy;
+		}
+
+		m_bdbs.add(bdb);
+		m_pages.add(page);
+	}
+
+	bool write(thread_db* tdbb, FbStatusVector* status)
+	{
+		if (m_written || m_bdbs.isEmpty())
+			return m_result;
+
+		m_written = true;
+
+		Database* const dbb = tdbb->getDatabase();
+		PageSpace* const pageSpace =
+			dbb->dbb_page_manager.findPageSpace(m_bdbs[0]->bdb_page.getPageSpaceID());
+		fb_assert(pageSpace);
+
+		const bool result = PIO_write_pages(tdbb, pageSpace->file,
+			m_bdbs.begin(), m_pages.begin(), m_bdbs.getCount(), status);
+
+		for (auto bdb : m_bdbs)
+		{
+			write_done(tdbb, bdb, result);
+			bdb->unLockIO(tdbb);
+
+			if (result)
+				clear_precedence(tdbb, bdb);
+		}
+
+		m_result = result;
+		return result;
+	}
+
+	BufferDesc** begin()
+	{
+		return m_bdbs.begin();
+	}
+
+	BufferDesc** end()
+	{
+		return m_bdbs.end();
+	}
+
+	void clear()
+	{
+		m_bdbs.clear();
+		m_pages.clear();
+		m_written = false;
+		m_result = true;
+	}
+
+private:
+	HalfStaticArray<BufferDesc*, 64> m_bdbs;
+	HalfStaticArray<Ods::pag*, 64> m_pages;
+	Array<UCHAR> m_copies;
+	const ULONG m_pageSize;
+	const ULONG m_ioBlockSize;
+	const FB_SIZE_T m_maxCount;
+	bool m_written;
+	bool m_result;
+};
+
+
 // Write array of pages to disk in efficient order.
 // First, sort pages by their numbers to make writes physically ordered and
 // thus faster. At every iteration of while loop write pages which have no high
 // precedence pages to ensure order preserved. If after some iteration there are
 // no such pages (i.e. all of not written yet pages have high precedence pages)
 // then write them all at last iteration (of course write_buffer will also check
-// for precedence before write).
+// for precedence before write). Adjacent pages written at the same iteration
+// are collected into a batch and written together.
 static void flushPages(thread_db* tdbb, USHORT flush_flag, BufferDesc** begin, FB_SIZE_T count)
 {
 	FbStatusVector* const status = tdbb->tdbb_status_vector;
+	Database* const dbb = tdbb->getDatabase();
 	const bool all_flag = (flush_flag & FLUSH_ALL) != 0;
 	const bool release_flag = (flush_flag & FLUSH_RLSE) != 0;
 	const bool write_thru = release_flag;
+	const SyncType syncType = release_flag ? SYNC_EXCLUSIVE : SYNC_SHARED;
 
 	qsort(begin, count, sizeof(BufferDesc*), cmpBdbs);
 
 	MarkIterator<BufferDesc*> iter(begin, count);
+	WriteBatch batch(*tdbb->getDefaultPool(), dbb);
+
+	const auto releasePage = [&](BufferDesc* bdb)
+	{
+		// release lock before losing control over bdb, it prevents
+		// concurrent operations on released lock
+		if (release_flag)
+			PAGE_LOCK_RELEASE(tdbb, bdb->bdb_bcb, bdb->bdb_lock);
+
+		bdb->release(tdbb, !release_flag && !(bdb->bdb_flags & BDB_dirty));
+	};
+
+	const auto writeBatch = [&]()
+	{
+		const bool result = batch.write(tdbb, status);
+
+		for (auto bdb : batch)
+			releasePage(bdb);
+
+		batch.clear();
+
+		if (!result)
+			CCH_unwind(tdbb, true);
+	};
 
 	FB_SIZE_T written = 0;
 	bool writeAll = false;
@@ -2805,7 +3092,15 @@ static void flushPages(thread_db* tdbb, USHORT flush_flag, BufferDesc** begin, F
 			if (!bdb)
 				continue;
 
-			bdb->addRef(tdbb, release_flag ? SYNC_EXCLUSIVE : SYNC_SHARED);
+			// Don't wait for a latch while latches of batched pages are held
+
+			if (batch.isEmpty())
+				bdb->addRef(tdbb, syncType);
+			else if (!bdb->addRefConditional(tdbb, syncType))
+			{
+				writeBatch();
+				bdb->addRef(tdbb, syncType);
+			}
 
 			BufferControl* bcb = bdb->bdb_bcb;
 			if (!writeAll)
@@ -2819,18 +3114,36 @@ static void flushPages(thread_db* tdbb, USHORT flush_flag, BufferDesc** begin, F
 						BUGCHECK(210);	// msg 210 page in use during flush
 				}
 
+				bool batched = false;
+
 				if (!all_flag || bdb->bdb_flags & (BDB_db_dirty | BDB_dirty))
 				{
-					if (!write_buffer(tdbb, bdb, bdb->bdb_page, write_thru, status, true))
+					// Shadows are written page by page, header page is written
+					// with special care, so batch other pages only. A page other
+					// pages depend on must be on disk before their precedence is
+					// cleared, and a page written during crypt state change must
+					// be written under crypto manager control, so don't batch them.
+
+					const bool canBatch = !writeAll && !dbb->dbb_shadow &&
+						bdb->bdb_page != HEADER_PAGE_NUMBER &&
+						QUE_EMPTY(bdb->bdb_higher) && QUE_EMPTY(bdb->bdb_lower) &&
+						dbb->dbb_crypto_manager->isSteady();
+
+					if (!canBatch || !batch.fits(bdb))
+						writeBatch();
+
+					if (!write_buffer(tdbb, bdb, bdb->bdb_page, write_thru, status, true,
+							canBatch ? &batch : nullptr))
+					{
+						writeBatch();
 						CCH_unwind(tdbb, true);
-				}
+					}
 
-				// release lock before losing control over bdb, it prevents
-				// concurrent operations on released lock
-				if (release_flag)
-					PAGE_LOCK_RELEASE(tdbb, bcb, bdb->bdb_lock);
+					batched = batch.contains(bdb);
+				}
 
-				bdb->release(tdbb, !release_flag && !(bdb->bdb_flags & BDB_dirty));
+				if (!batched)
+					releasePage(bdb);
 
 				iter.mark();
 				found = true;
@@ -2842,6 +3155,8 @@ static void flushPages(thread_db* tdbb, USHORT flush_flag, BufferDesc** begin, F
 			}
 		}
 
+		writeBatch();
+
 		if (!found)
 			writeAll = true;
 
@@ -3052,6 +3367,16 @@ void BufferControl::cache_writer(BufferControl* bcb)
 			// Notify our creator that we have started
 			bcb->bcb_writer_init.release();
 
+			// Pages cached before the last shutdown are read back in our spare time
+
+			const bool prewarm = dbb->dbb_config->getCachePrewarm();
+			Array<ULONG> prewarmPages(*attachment->att_pool);
+			FB_SIZE_T prewarmPos = 0;
+			time_t prewarmSaved = time(NULL);
+
+			if (prewarm)
+				prewarm_load(tdbb, prewarmPages);
+
 			while (bcb->bcb_flags & BCB_cache_writer)
 			{
 				bcb->bcb_flags |= BCB_writer_active;
@@ -3104,13 +3429,29 @@ void BufferControl::cache_writer(BufferControl* bcb)
 					prefetch_epilogue(&prefetch, status_vector);
 				}
 #endif
+				else if (read_ahead_pages(tdbb, bcb))
+					attachment->mergeStats();
+				else if (prewarmPos < prewarmPages.getCount())
+				{
+					prewarmPos = prewarm_pages(tdbb, bcb, prewarmPages, prewarmPos);
+					attachment->mergeStats();
+				}
 				else
 				{
+					if (prewarm && time(NULL) - prewarmSaved >= PREWARM_SAVE_INTERVAL)
+					{
+						prewarm_save(tdbb, bcb);
+						prewarmSaved = time(NULL);
+					}
+
 					bcb->bcb_flags &= ~BCB_writer_active;
 					EngineCheckout cout(tdbb, FB_FUNCTION);
 					bcb->bcb_writer_sem.tryEnter(10);
 				}
 			}
+
+			if (prewarm)
+				prewarm_save(tdbb, bcb);
 		}
 		catch (const Firebird::Exception& ex)
 		{
@@ -3655,6 +3996,214 @@ static BufferDesc* get_dirty_buffer(thread_db* tdbb)
 }
 
 
+static bool read_ahead_pages(thread_db* tdbb, BufferControl* bcb)
+{
+/**************************************
+ *
+ *	r e a d _ a h e a d _ p a g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Read next portion of pages queued by CCH_read_ahead
+ *	into the cache. Return false if the queue is empty.
+ *
+ **************************************/
+	HalfStaticArray<PageNumber, READ_AHEAD_MAX_PAGES> pages;
+
+	{ // scope
+		MutexLockGuard guard(bcb->bcb_read_ahead_mutex, FB_FUNCTION);
+
+		if (bcb->bcb_read_ahead.isEmpty())
+			return false;
+
+		const FB_SIZE_T count = MIN(bcb->bcb_read_ahead.getCount(), (FB_SIZE_T) READ_AHEAD_MAX_PAGES);
+		pages.add(bcb->bcb_read_ahead.begin(), count);
+		bcb->bcb_read_ahead.removeCount(0, count);
+	}
+
+	try
+	{
+		for (const PageNumber* page = pages.begin(); page < pages.end(); page++)
+		{
+			// Page being read by somebody else is not waited for
+
+			WIN window(*page);
+			if (CCH_FETCH_TIMEOUT(tdbb, &window, LCK_read, pag_undefined, 0))
+				CCH_RELEASE(tdbb, &window);
+		}
+	}
+	catch (const Exception&)
+	{
+		// Read ahead is just a hint, the error is reported by the following fetch
+		fb_utils::init_status(tdbb->tdbb_status_vector);
+	}
+
+	return true;
+}
+
+
+static void prewarm_load(thread_db* tdbb, Array<ULONG>& pages)
+{
+/**************************************
+ *
+ *	p r e w a r m _ l o a d
+ *
+ **************************************
+ *
+ * Functional description
+ *	Load the list of pages saved by prewarm_save().
+ *	Pages past the end of database file are skipped.
+ *
+ **************************************/
+	Database* const dbb = tdbb->getDatabase();
+	const PathName fileName = dbb->dbb_filename + PREWARM_SUFFIX;
+
+	EngineCheckout cout(tdbb, FB_FUNCTION);
+
+	FILE* const file = os_utils::fopen(fileName.c_str(), "rb");
+	if (!file)
+		return;
+
+	ULONG header[2];
+	if (fread(header, sizeof(header), 1, file) == 1 &&
+		header[0] == PREWARM_VERSION && header[1] == dbb->dbb_page_size)
+	{
+		ULONG buffer[1024];
+		size_t count;
+
+		while ((count = fread(buffer, sizeof(ULONG), FB_NELEM(buffer), file)) > 0)
+			pages.add(buffer, count);
+	}
+
+	fclose(file);
+
+	const PageSpace* const pageSpace = dbb->dbb_page_manager.findPageSpace(DB_PAGE_SPACE);
+	const ULONG maxPage = PIO_get_number_of_pages(pageSpace->file, dbb->dbb_page_size);
+
+	FB_SIZE_T count = 0;
+	while (count < pages.getCount() && pages[count] < maxPage)
+		count++;
+
+	pages.shrink(count);
+}
+
+
+static FB_SIZE_T prewarm_pages(thread_db* tdbb, BufferControl* bcb, const Array<ULONG>& pages,
+	FB_SIZE_T pos)
+{
+/**************************************
+ *
+ *	p r e w a r m _ p a g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Read next portion of saved pages into the cache.
+ *	Return position of the next portion, or end of
+ *	list if there is nothing to do anymore.
+ *
+ **************************************/
+
+	// Don't evict pages loaded on user demand, fill empty buffers only
+
+	if (QUE_EMPTY(bcb->bcb_empty))
+		return pages.getCount();
+
+	const FB_SIZE_T end = MIN(pos + PREWARM_CHUNK, pages.getCount());
+
+	try
+	{
+		CCH_read_ahead(tdbb, DB_PAGE_SPACE, pages.begin() + pos, (USHORT) (end - pos));
+
+		for (; pos < end; pos++)
+		{
+			WIN window(DB_PAGE_SPACE, pages[pos]);
+			CCH_FETCH(tdbb, &window, LCK_read, pag_undefined);
+			CCH_RELEASE(tdbb, &window);
+		}
+	}
+	catch (const Exception& ex)
+	{
+		// Failed prewarm should not stop cache writer
+
+		FbLocalStatus status;
+		ex.stuffException(&status);
+		iscDbLogStatus(tdbb->getDatabase()->dbb_filename.c_str(), &status);
+
+		return pages.getCount();
+	}
+
+	return pos;
+}
+
+
+static void prewarm_save(thread_db* tdbb, BufferControl* bcb)
+{
+/**************************************
+ *
+ *	p r e w a r m _ s a v e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Save the numbers of database pages in the cache,
+ *	in ascending order, to be read back at next start.
+ *
+ **************************************/
+	Database* const dbb = tdbb->getDatabase();
+	Array<ULONG> pages(*tdbb->getDefaultPool());
+
+	{ // scope
+		Sync lruSync(&bcb->bcb_syncLRU, FB_FUNCTION);
+		lruSync.lock(SYNC_SHARED);
+
+		for (QUE que_inst = bcb->bcb_in_use.que_forward;
+			 que_inst != &bcb->bcb_in_use; que_inst = que_inst->que_forward)
+		{
+			const BufferDesc* const bdb = BLOCK(que_inst, BufferDesc, bdb_in_use);
+
+			if (bdb->bdb_page.getPageSpaceID() == DB_PAGE_SPACE &&
+				!(bdb->bdb_flags & (BDB_read_pending | BDB_not_valid | BDB_free_pending)))
+			{
+				pages.add(bdb->bdb_page.getPageNum());
+			}
+		}
+	}
+
+	std::sort(pages.begin(), pages.end());
+
+	const PathName fileName = dbb->dbb_filename + PREWARM_SUFFIX;
+	const PathName tempName = fileName + ".tmp";
+
+	EngineCheckout cout(tdbb, FB_FUNCTION);
+
+	FILE* const file = os_utils::fopen(tempName.c_str(), "wb");
+	if (!file)
+		return;
+
+	const ULONG header[2] = {PREWARM_VERSION, dbb->dbb_page_size};
+	bool done = fwrite(header, sizeof(header), 1, file) == 1 &&
+		fwrite(pages.begin(), sizeof(ULONG), pages.getCount(), file) == pages.getCount();
+
+	done = !fclose(file) && done;
+
+	// On POSIX rename() replaces the old list atomically, so a crash can't
+	// leave the database without it. On Windows it fails if the target exists.
+
+	if (done)
+	{
+#ifdef WIN_NT
+		remove(fileName.c_str());
+#endif
+		done = !rename(tempName.c_str(), fileName.c_str());
+	}
+
+	if (!done)
+		remove(tempName.c_str());
+}
+
+
 static BufferDesc* get_oldest_buffer(thread_db* tdbb, BufferControl* bcb)
 {
 /**************************************
@@ -3667,7 +4216,7 @@ static BufferDesc* get_oldest_buffer(thread_db* tdbb, BufferControl* bcb)
 	BufferDesc* bdb = nullptr;
 
 	Sync lruSync(&bcb->bcb_syncLRU, FB_FUNCTION);
-	if (bcb->bcb_lru_chain.load() != NULL)
+	if (hasRecentlyUsed(bcb))
 	{
 		lruSync.lock(SYNC_EXCLUSIVE);
 		requeueRecentlyUsed(bcb);
@@ -3766,7 +4315,8 @@ static BufferDesc* get_oldest_buffer(thread_db* tdbb, BufferControl* bcb)
 }
 
 
-static BufferDesc* get_buffer(thread_db* tdbb, const PageNumber page, SyncType syncType, int wait)
+static BufferDesc* get_buffer(thread_db* tdbb, const PageNumber page, SyncType syncType, int wait,
+	bool lowPriority)
 {
 /**************************************
  *
@@ -3787,6 +4337,9 @@ static BufferDesc* get_buffer(thread_db* tdbb, const PageNumber page, SyncType s
  *			0 => If the lock can't be acquired immediately,
  *				give up and return 0;
  *			<negative number> => Latch timeout interval in seconds.
+ *	lowPriority:	page is fetched by a large scan. Don't move the buffer
+ *				to the LRU head if the page is found in cache, and put
+ *				a newly assigned buffer to the LRU tail.
  *
  * return
  *	BufferDesc pointer if successful.
@@ -3807,7 +4360,8 @@ static BufferDesc* get_buffer(thread_db* tdbb, const PageNumber page, SyncType s
 			{
 				if (bdb->bdb_page == page)
 				{
-					recentlyUsed(bdb);
+					if (!lowPriority)
+						recentlyUsed(bdb);
 					tdbb->bumpStats(RuntimeStatistics::PAGE_FETCHES);
 					return bdb;
 				}
@@ -3850,7 +4404,8 @@ static BufferDesc* get_buffer(thread_db* tdbb, const PageNumber page, SyncType s
 				// ensure the found page buffer is still for the same page after latch
 				if (bdb->bdb_page == page)
 				{
-					recentlyUsed(bdb);
+					if (!lowPriority)
+						recentlyUsed(bdb);
 					tdbb->bumpStats(RuntimeStatistics::PAGE_FETCHES);
 					cacheBuffer(att, bdb);
 					return bdb;
@@ -3930,9 +4485,12 @@ static BufferDesc* get_buffer(thread_db* tdbb, const PageNumber page, SyncType s
 						if (syncLRU.lockConditional(SYNC_EXCLUSIVE))
 						{
 							QUE_DELETE(bdb->bdb_in_use);
-							QUE_INSERT(bcb->bcb_in_use, bdb->bdb_in_use);
+							if (lowPriority)
+								QUE_APPEND(bcb->bcb_in_use, bdb->bdb_in_use);
+							else
+								QUE_INSERT(bcb->bcb_in_use, bdb->bdb_in_use);
 						}
-						else
+						else if (!lowPriority || is_empty)
 							recentlyUsed(bdb);
 					}
 					tdbb->bumpStats(RuntimeStatistics::PAGE_FETCHES);
@@ -4543,7 +5101,7 @@ static void prefetch_prologue(Prefetch* prefetch, SLONG* start_page)
 	{
 		*next_bdb = 0;
 		if (SBM_clear(bcb->bcb_prefetch, *start_page) &&
-			(*next_bdb = get_buffer(tdbb, *start_page, LATCH_shared, 0)))
+			(*next_bdb = get_buffer(tdbb, *start_page, LATCH_shared, 0, false)))
 		{
 			if ((*next_bdb)->bdb_flags & BDB_read_pending)
 				prefetch->prf_page_count = i + 1;
@@ -4706,7 +5264,8 @@ static int write_buffer(thread_db* tdbb,
 						BufferDesc* bdb,
 						const PageNumber page,
 						const bool write_thru,
-						FbStatusVector* const status, const bool write_this_page)
+						FbStatusVector* const status, const bool write_this_page,
+						WriteBatch* batch)
 {
 /**************************************
  *
@@ -4737,6 +5296,11 @@ static int write_buffer(thread_db* tdbb,
  *		though.  Probable action: re-establich the
  * 		need to write this page and retry write.
  *
+ * batch:  if not NULL, the page may be appended to the batch
+ *		instead of being written. Then it stays I/O locked
+ *		until the batch is written. If the page has higher
+ *		precedence pages, the batch is written first.
+ *
  **************************************/
 	SET_TDBB(tdbb);
 #ifdef SUPERSERVER_V2
@@ -4765,6 +5329,20 @@ static int write_buffer(thread_db* tdbb,
 	BufferControl *bcb = bdb->bdb_bcb;
 	if (QUE_NOT_EMPTY(bdb->bdb_higher))
 	{
+		// Batched pages may be among the higher ones. Get them on disk
+		// before the precedence is cleared and write this page alone.
+
+		if (batch)
+		{
+			if (!batch->write(tdbb, status))
+			{
+				bdb->unLockIO(tdbb);
+				return 0;
+			}
+
+			batch = nullptr;
+		}
+
 		Sync syncPrec(&bcb->bcb_syncPrecedence, "write_buffer");
 
 		while (true)
@@ -4834,7 +5412,10 @@ static int write_buffer(thread_db* tdbb,
 	if ((bdb->bdb_flags & BDB_dirty || (write_thru && bdb->bdb_flags & BDB_db_dirty)) &&
 		!(bdb->bdb_flags & BDB_marked))
 	{
-		result = write_page(tdbb, bdb, status, false);
+		result = write_page(tdbb, bdb, status, false, batch);
+
+		if (result && batch && batch->contains(bdb))
+			return 1;
 	}
 
 	bdb->unLockIO(tdbb);
@@ -4851,7 +5432,8 @@ static int write_buffer(thread_db* tdbb,
 }
 
 
-static bool write_page(thread_db* tdbb, BufferDesc* bdb, FbStatusVector* const status, const bool inAst)
+static bool write_page(thread_db* tdbb, BufferDesc* bdb, FbStatusVector* const status, const bool inAst,
+	WriteBatch* batch)
 {
 /**************************************
  *
@@ -4980,14 +5562,20 @@ static bool write_page(thread_db* tdbb, BufferDesc* bdb, FbStatusVector* const s
 				class Pio : public CryptoManager::IOCallback
 				{
 				public:
-					Pio(jrd_file* f, BufferDesc* b, bool ast, bool tp, PageSpace* ps)
-						: file(f), bdb(b), inAst(ast), isTempPage(tp), pageSpace(ps)
+					Pio(jrd_file* f, BufferDesc* b, bool ast, bool tp, PageSpace* ps, WriteBatch* wb)
+						: file(f), bdb(b), inAst(ast), isTempPage(tp), pageSpace(ps), batch(wb)
 					{ }
 
 					bool callback(thread_db* tdbb, FbStatusVector* status, Ods::pag* page)
 					{
 						Database* dbb = tdbb->getDatabase();
 
+						if (batch)
+						{
+							batch->add(bdb, page);
+							return true;
+						}
+
 						while (!PIO_write(tdbb, file, bdb, page, status))
 						{
 							if (isTempPage || !CCH_rollover_to_shadow(tdbb, dbb, file, inAst))
@@ -5018,22 +5606,46 @@ static bool write_page(thread_db* tdbb, BufferDesc* bdb, FbStatusVector* const s
 					bool inAst;
 					bool isTempPage;
 					PageSpace* pageSpace;
+					WriteBatch* batch;
 				};
 
-				Pio io(pageSpace->file, bdb, inAst, isTempPage, pageSpace);
+				Pio io(pageSpace->file, bdb, inAst, isTempPage, pageSpace, batch);
 				result = dbb->dbb_crypto_manager->write(tdbb, status, page, &io);
 				if (!result && (bdb->bdb_flags & BDB_io_error))
 				{
 					return false;
 				}
 
+				// Batched page is completed by write_done() when the batch is written
+
+				if (result && batch && batch->contains(bdb))
+					return true;
 			}
 		}
-
-		if (result)
-			bdb->bdb_flags &= ~BDB_db_dirty;
 	}
 
+	write_done(tdbb, bdb, result);
+	return result;
+}
+
+
+static void write_done(thread_db* tdbb, BufferDesc* bdb, const bool result)
+{
+/**************************************
+ *
+ *	w r i t e _ d o n e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Update buffer state after the page write.
+ *
+ **************************************/
+	Database* const dbb = tdbb->getDatabase();
+
+	if (result)
+		bdb->bdb_flags &= ~BDB_db_dirty;
+
 	if (!result)
 	{
 		// If there was a write error then idle background threads
@@ -5071,8 +5683,6 @@ static bool write_page(thread_db* tdbb, BufferDesc* bdb, FbStatusVector* const s
 			dbb->dbb_flags &= ~DBB_suspend_bgio;
 		}
 	}
-
-	return result;
 }
 
 static void clear_dirty_flag_and_nbak_state(thread_db* tdbb, BufferDesc* bdb)
@@ -5099,18 +5709,26 @@ void recentlyUsed(BufferDesc* bdb)
 
 	BufferControl* bcb = bdb->bdb_bcb;
 
+	// Spread buffers over the pending chains to not make all attachments
+	// compete for the single chain head
+
+	std::atomic<BufferDesc*>& head = bcb->bcb_lru_chain[bdb->bdb_page.getPageNum() % BCB_LRU_CHAINS];
+
 #ifdef DEV_BUILD
-	volatile BufferDesc* chain = bcb->bcb_lru_chain;
-	for (; chain; chain = chain->bdb_lru_chain)
+	for (ULONG i = 0; i < BCB_LRU_CHAINS; i++)
 	{
-		if (chain == bdb)
-			BUGCHECK(-1); // !!
+		volatile BufferDesc* chain = bcb->bcb_lru_chain[i];
+		for (; chain; chain = chain->bdb_lru_chain)
+		{
+			if (chain == bdb)
+				BUGCHECK(-1); // !!
+		}
 	}
 #endif
 	for (;;)
 	{
-		bdb->bdb_lru_chain = bcb->bcb_lru_chain;
-		if (bcb->bcb_lru_chain.compare_exchange_strong(bdb->bdb_lru_chain, bdb))
+		bdb->bdb_lru_chain = head;
+		if (head.compare_exchange_strong(bdb->bdb_lru_chain, bdb))
 			break;
 	}
 }
@@ -5118,43 +5736,49 @@ void recentlyUsed(BufferDesc* bdb)
 
 void requeueRecentlyUsed(BufferControl* bcb)
 {
-	BufferDesc* chain = NULL;
+	for (ULONG i = 0; i < BCB_LRU_CHAINS; i++)
+	{
+		// Let's pick up the LRU pending chain, if any
 
-	// Let's pick up the LRU pending chain, if any
+		BufferDesc* chain = bcb->bcb_lru_chain[i].exchange(NULL);
 
-	for (;;)
-	{
-		chain = bcb->bcb_lru_chain;
-		if (bcb->bcb_lru_chain.compare_exchange_strong(chain, NULL))
-			break;
-	}
+		if (!chain)
+			continue;
 
-	if (!chain)
-		return;
+		// Next, let's flip the order
 
-	// Next, let's flip the order
+		BufferDesc* reversed = NULL;
+		BufferDesc* bdb;
 
-	BufferDesc* reversed = NULL;
-	BufferDesc* bdb;
+		while ((bdb = chain) != NULL)
+		{
+			chain = bdb->bdb_lru_chain;
+			bdb->bdb_lru_chain = reversed;
+			reversed = bdb;
+		}
 
-	while ((bdb = chain) != NULL)
-	{
-		chain = bdb->bdb_lru_chain;
-		bdb->bdb_lru_chain = reversed;
-		reversed = bdb;
+		while ((bdb = reversed) != NULL)
+		{
+			reversed = bdb->bdb_lru_chain;
+			QUE_DELETE(bdb->bdb_in_use);
+			QUE_INSERT(bcb->bcb_in_use, bdb->bdb_in_use);
+
+			bdb->bdb_lru_chain = NULL;
+			bdb->bdb_flags &= ~BDB_lru_chained;
+		}
 	}
+}
 
-	while ((bdb = reversed) != NULL)
-	{
-		reversed = bdb->bdb_lru_chain;
-		QUE_DELETE(bdb->bdb_in_use);
-		QUE_INSERT(bcb->bcb_in_use, bdb->bdb_in_use);
 
-		bdb->bdb_lru_chain = NULL;
-		bdb->bdb_flags &= ~BDB_lru_chained;
+bool hasRecentlyUsed(const BufferControl* bcb)
+{
+	for (ULONG i = 0; i < BCB_LRU_CHAINS; i++)
+	{
+		if (bcb->bcb_lru_chain[i].load() != NULL)
+			return true;
 	}
 
-	chain = bcb->bcb_lru_chain;
+	return false;
 }
 
 
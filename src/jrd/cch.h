@@ -73,6 +73,16 @@ const ULONG MAX_PAGE_BUFFERS = 131072;
 const ULONG MAX_PAGE_BUFFERS = MAX_SLONG - 1;
 #endif
 
+// Read-ahead of large scans. Data pages are requested in portions of
+// READ_AHEAD_TRANSFER bytes, two portions ahead of the scan.
+
+const ULONG READ_AHEAD_TRANSFER = 256 * 1024;
+const ULONG READ_AHEAD_MAX_PAGES = 2 * READ_AHEAD_TRANSFER / MIN_PAGE_SIZE;
+
+// Number of pending LRU chains, see BufferControl::bcb_lru_chain
+
+const ULONG BCB_LRU_CHAINS = 16;
+
 // BufferControl -- Buffer control block -- one per system
 
 class BufferControl : public pool_alloc<type_bcb>
@@ -82,6 +92,7 @@ class BufferControl : public pool_alloc<type_bcb>
 		  bcb_memory_stats(&parentStats),
 		  bcb_memory(p),
 		  bcb_writer_fini(p, cache_writer, THREAD_medium),
+		  bcb_read_ahead(p),
 		  bcb_bdbBlocks(p)
 	{
 		bcb_database = NULL;
@@ -99,6 +110,9 @@ class BufferControl : public pool_alloc<type_bcb>
 		bcb_page_size = 0;
 		bcb_page_incarnation = 0;
 		bcb_hashTable = nullptr;
+
+		for (ULONG i = 0; i < BCB_LRU_CHAINS; i++)
+			bcb_lru_chain[i] = NULL;
 #ifdef SUPERSERVER_V2
 		bcb_prefetch = NULL;
 #endif
@@ -120,9 +134,10 @@ public:
 	que			bcb_empty;			// Que of empty buffers
 
 	// Recently used buffer put there without locking common LRU que (bcb_in_use).
-	// When bcb_syncLRU is locked this chain is merged into bcb_in_use. See also
+	// Buffers are spread over a few chains by page number to reduce contention.
+	// When bcb_syncLRU is locked these chains are merged into bcb_in_use. See also
 	// requeueRecentlyUsed() and recentlyUsed()
-	std::atomic<BufferDesc*>	bcb_lru_chain;
+	std::atomic<BufferDesc*>	bcb_lru_chain[BCB_LRU_CHAINS];
 
 	que			bcb_dirty;			// que of dirty buffers
 	SLONG		bcb_dirty_count;	// count of pages in dirty page btree
@@ -151,6 +166,9 @@ public:
 	Firebird::Semaphore bcb_writer_sem;		// Wake up cache writer
 	Firebird::Semaphore bcb_writer_init;	// Cache writer initialization
 	BcbThreadSync bcb_writer_fini;			// Cache writer finalization
+
+	Firebird::Mutex bcb_read_ahead_mutex;
+	Firebird::Array<PageNumber> bcb_read_ahead;	// Pages to be read ahead by cache writer
 #ifdef SUPERSERVER_V2
 	static void cache_reader(BufferControl* bcb);
 	// the code in cch.cpp is not tested for semaphore instead event !!!
@@ -55,6 +55,7 @@ namespace Ods
 }
 
 Ods::pag* DPM_allocate(Jrd::thread_db*, Jrd::win*);
+bool	DPM_all_visible(Jrd::thread_db*, Jrd::jrd_rel*, ULONG, UCHAR*);
 void	DPM_backout(Jrd::thread_db*, Jrd::record_param*);
 void	DPM_backout_mark(Jrd::thread_db*, Jrd::record_param*, const Jrd::jrd_tra*);
 double	DPM_cardinality(Jrd::thread_db*, Jrd::jrd_rel*, const Jrd::Format*);
@@ -75,6 +76,8 @@ void	DPM_pages(Jrd::thread_db*, SSHORT, int, ULONG, ULONG);
 SLONG	DPM_prefetch_bitmap(Jrd::thread_db*, Jrd::jrd_rel*, Jrd::PageBitmap*, SLONG);
 #endif
 ULONG	DPM_pointer_pages(Jrd::thread_db*, Jrd::jrd_rel*);
+void	DPM_range_records(Jrd::thread_db*, Jrd::jrd_rel*, ULONG, ULONG, Jrd::RecordBitmap**, Jrd::RecordBitmap*);
+SINT64	DPM_read_ahead(Jrd::thread_db*, Jrd::jrd_rel*, Jrd::RecordBitmap*, SINT64);
 void	DPM_scan_pages(Jrd::thread_db*);
 void	DPM_store(Jrd::thread_db*, Jrd::record_param*, Jrd::PageStack&, const Jrd::RecordStorageType type);
 RecordNumber DPM_store_blob(Jrd::thread_db*, Jrd::blb*, Jrd::Record*);
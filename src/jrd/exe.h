@@ -121,6 +121,7 @@ const int csb_unmatched		= 512;		// stream has conjuncts unmatched by any index
 const int csb_update		= 1024;		// erase or modify for relation
 const int csb_unstable		= 2048;		// unstable explicit cursor
 const int csb_skip_locked	= 4096;		// skip locked record
+const int csb_record_version	= 8192;	// record version is referenced
 
 
 // Aggregate Sort Block (for DISTINCT aggregates)
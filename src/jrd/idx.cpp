@@ -75,6 +75,7 @@ static idx_e check_foreign_key(thread_db*, Record*, jrd_rel*, jrd_tra*, index_de
 static idx_e check_partner_index(thread_db*, jrd_rel*, Record*, jrd_tra*, index_desc*, jrd_rel*, USHORT);
 static bool cmpRecordKeys(thread_db*, Record*, jrd_rel*, index_desc*, Record*, jrd_rel*, index_desc*);
 static bool duplicate_key(const UCHAR*, const UCHAR*, void*);
+static BulkIndexKeys* get_bulk_keys(thread_db*, jrd_rel*, jrd_tra*);
 static PageNumber get_root_page(thread_db*, jrd_rel*);
 static int index_block_flush(void*);
 static idx_e insert_key(thread_db*, jrd_rel*, Record*, jrd_tra*, WIN *, index_insertion*, IndexErrorContext&);
@@ -823,6 +824,246 @@ int IndexCreateTask::getMaxWorkers()
 }; // namespace Jrd
 
 
+BulkIndexKeys::~BulkIndexKeys()
+{
+	for (Buffer* buffer = m_buffers.begin(); buffer < m_buffers.end(); buffer++)
+		delete buffer->sort;
+}
+
+bool BulkIndexKeys::put(thread_db* tdbb, jrd_tra* transaction, jrd_rel* relation,
+	index_desc* idx, const temporary_key* key, RecordNumber number)
+{
+/**************************************
+ *
+ *	B u l k I n d e x K e y s : : p u t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Put the key into the sort of its index. Return false if the
+ *	key must be inserted into the index immediately.
+ *
+ **************************************/
+	Database* const dbb = tdbb->getDatabase();
+
+	Buffer* buffer = NULL;
+	for (Buffer* item = m_buffers.begin(); item < m_buffers.end(); item++)
+	{
+		if (item->relation == relation && item->id == idx->idx_id)
+		{
+			buffer = item;
+			break;
+		}
+	}
+
+	if (!buffer)
+	{
+		// Sort record is made the same way as for index creation
+
+		const bool isDescending = (idx->idx_flags & idx_descending);
+		const USHORT nullIndLen = !isDescending && (idx->idx_count == 1) ? 1 : 0;
+		const USHORT keyLength = ROUNDUP(BTR_key_length(tdbb, relation, idx) + nullIndLen, sizeof(SINT64));
+
+		if (keyLength >= dbb->getMaxIndexKeyLength())
+			return false;
+
+		sort_key_def key_desc[2];
+		// Key sort description
+		key_desc[0].setSkdLength(SKD_bytes, keyLength);
+		key_desc[0].skd_flags = SKD_ascending;
+		key_desc[0].setSkdOffset();
+		key_desc[0].skd_vary_offset = 0;
+		// RecordNumber sort description
+		key_desc[1].setSkdLength(SKD_int64, sizeof(RecordNumber));
+		key_desc[1].skd_flags = SKD_ascending;
+		key_desc[1].setSkdOffset(key_desc);
+		key_desc[1].skd_vary_offset = 0;
+
+		Buffer& item = m_buffers.add();
+		item.relation = relation;
+		item.id = idx->idx_id;
+		item.keyLength = keyLength;
+		item.nullIndLen = nullIndLen;
+		item.size = 0;
+		item.sort = FB_NEW_POOL(transaction->tra_sorts.getPool())
+			Sort(dbb, &transaction->tra_sorts, keyLength + sizeof(index_sort_record),
+				 2, 1, key_desc, NULL, NULL);
+
+		buffer = &item;
+	}
+
+	if (key->key_length + buffer->nullIndLen > buffer->keyLength)
+		return false;
+
+	UCHAR* p;
+	buffer->sort->put(tdbb, reinterpret_cast<ULONG**>(&p));
+
+	if (buffer->nullIndLen)
+		*p++ = (key->key_length == 0) ? 0 : 1;
+
+	if (key->key_length > 0)
+	{
+		memcpy(p, key->key_data, key->key_length);
+		p += key->key_length;
+	}
+
+	const int l = int(buffer->keyLength) - buffer->nullIndLen - key->key_length;
+
+	if (l > 0)
+	{
+		memset(p, (idx->idx_flags & idx_descending) ? -1 : 0, l);
+		p += l;
+	}
+
+	index_sort_record* isr = (index_sort_record*) p;
+	isr->isr_record_number = number.getValue();
+	isr->isr_key_length = key->key_length;
+	isr->isr_flags = 0;
+
+	buffer->size += buffer->keyLength + sizeof(index_sort_record);
+
+	if (buffer->size >= dbb->dbb_config->getBulkIndexBuffer())
+		m_full = true;
+
+	return true;
+}
+
+bool BulkIndexKeys::isDeferrable(thread_db* tdbb, jrd_rel* relation)
+{
+/**************************************
+ *
+ *	B u l k I n d e x K e y s : : i s D e f e r r a b l e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Check whether keys of the relation could be deferred. They could
+ *	not if an index expression or condition calls a procedure or
+ *	function, as it would run while the index root page is held and
+ *	could read the relation without the deferred keys.
+ *
+ **************************************/
+	for (const Relation* item = m_relations.begin(); item < m_relations.end(); item++)
+	{
+		if (item->relation == relation)
+			return item->deferrable;
+	}
+
+	IndexDescList indices;
+	BTR_all(tdbb, relation, indices, relation->getPages(tdbb));
+
+	bool deferrable = true;
+
+	for (const index_desc* idx = indices.begin(); idx < indices.end(); idx++)
+	{
+		if ((idx->idx_expression_statement &&
+				(idx->idx_expression_statement->flags & Statement::FLAG_ROUTINES)) ||
+			(idx->idx_condition_statement &&
+				(idx->idx_condition_statement->flags & Statement::FLAG_ROUTINES)))
+		{
+			deferrable = false;
+			break;
+		}
+	}
+
+	Relation& item = m_relations.add();
+	item.relation = relation;
+	item.deferrable = deferrable;
+
+	return deferrable;
+}
+
+void BulkIndexKeys::flush(thread_db* tdbb, jrd_tra* transaction)
+{
+/**************************************
+ *
+ *	B u l k I n d e x K e y s : : f l u s h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Insert all collected keys into their indices.
+ *
+ **************************************/
+
+	// Buffer is detached before it's applied, thus the failed one
+	// is not applied again while the statement is undone
+
+	while (m_buffers.hasData())
+	{
+		const Buffer buffer = m_buffers.pop();
+		AutoPtr<Sort> sort(buffer.sort);
+
+		apply(tdbb, transaction, buffer);
+	}
+
+	// Index definitions may change before the next statement
+
+	m_relations.clear();
+	m_full = false;
+}
+
+void BulkIndexKeys::apply(thread_db* tdbb, jrd_tra* transaction, const Buffer& buffer)
+{
+/**************************************
+ *
+ *	B u l k I n d e x K e y s : : a p p l y
+ *
+ **************************************
+ *
+ * Functional description
+ *	Insert keys of the buffer into its index in key order.
+ *
+ **************************************/
+	jrd_rel* const relation = buffer.relation;
+	RelationPages* const relPages = relation->getPages(tdbb);
+
+	index_desc idx;
+	if (!BTR_lookup(tdbb, relation, buffer.id, &idx, relPages))
+		return;
+
+	buffer.sort->sort(tdbb);
+
+	temporary_key key;
+	key.key_flags = 0;
+	key.key_nulls = 0;
+
+	index_insertion insertion;
+	insertion.iib_relation = relation;
+	insertion.iib_descriptor = &idx;
+	insertion.iib_transaction = transaction;
+	insertion.iib_key = &key;
+	insertion.iib_btr_level = 0;
+
+	WIN window(relPages->rel_pg_space_id, -1);
+
+	while (true)
+	{
+		UCHAR* record;
+		buffer.sort->get(tdbb, reinterpret_cast<ULONG**>(&record));
+
+		if (!record)
+			break;
+
+		const index_sort_record* isr = (index_sort_record*) (record + buffer.keyLength);
+
+		key.key_length = isr->isr_key_length;
+		memcpy(key.key_data, record + buffer.nullIndLen, key.key_length);
+
+		insertion.iib_number.setValue(isr->isr_record_number);
+		insertion.iib_duplicates = NULL;
+
+		window.win_page = get_root_page(tdbb, relation);
+		window.win_flags = 0;
+		CCH_FETCH(tdbb, &window, LCK_read, pag_root);
+
+		BTR_insert(tdbb, &window, &insertion);
+
+		JRD_reschedule(tdbb);
+	}
+}
+
+
 void IDX_create_index(thread_db* tdbb,
 					  jrd_rel* relation,
 					  index_desc* idx,
@@ -1135,6 +1376,33 @@ void IDX_erase(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 }
 
 
+void IDX_flush_bulk_keys(thread_db* tdbb, jrd_tra* transaction, bool onlyFull)
+{
+/**************************************
+ *
+ *	I D X _ f l u s h _ b u l k _ k e y s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Insert keys deferred by bulk inserts into the indices.
+ *	If onlyFull is set, do it only if the keys buffer is full.
+ *	Never called from inside IDX_store, as the index root page
+ *	must not be held while the keys are inserted.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	if (!transaction || !transaction->tra_bulk_keys)
+		return;
+
+	BulkIndexKeys* const bulkKeys = transaction->tra_bulk_keys;
+
+	if (!onlyFull || bulkKeys->isFull())
+		bulkKeys->flush(tdbb, transaction);
+}
+
+
 void IDX_garbage_collect(thread_db* tdbb, record_param* rpb, RecordStack& going, RecordStack& staying)
 {
 /**************************************
@@ -1540,6 +1808,12 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 	RelationPages* relPages = rpb->rpb_relation->getPages(tdbb);
 	WIN window(relPages->rel_pg_space_id, -1);
 
+	// Bulk insert may defer keys of non-unique indices up to the end of statement
+
+	BulkIndexKeys* bulkKeys = NULL;
+	if (rpb->rpb_stream_flags & RPB_s_bulk_index)
+		bulkKeys = get_bulk_keys(tdbb, rpb->rpb_relation, transaction);
+
 	while (BTR_next_index(tdbb, rpb->rpb_relation, transaction, &idx, &window))
 	{
 		IndexErrorContext context(rpb->rpb_relation, &idx);
@@ -1573,6 +1847,15 @@ void IDX_store(thread_db* tdbb, record_param* rpb, jrd_tra* transaction)
 
 		insertion.iib_key = key;
 
+		// Keys of unique and foreign key indices are checked immediately
+
+		if (bulkKeys && !(idx.idx_flags & (idx_unique | idx_foreign | idx_block_range)) &&
+			!insertion.iib_key->key_next &&
+			bulkKeys->put(tdbb, transaction, rpb->rpb_relation, &idx, insertion.iib_key, rpb->rpb_number))
+		{
+			continue;
+		}
+
 		if ( (error_code = insert_key(tdbb, rpb->rpb_relation, rpb->rpb_record, transaction,
 									  &window, &insertion, context)) )
 		{
@@ -2019,6 +2302,41 @@ static bool duplicate_key(const UCHAR* record1, const UCHAR* record2, void* ifl_
 }
 
 
+static BulkIndexKeys* get_bulk_keys(thread_db* tdbb, jrd_rel* relation, jrd_tra* transaction)
+{
+/**************************************
+ *
+ *	g e t _ b u l k _ k e y s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Return keys collector of the transaction if keys of the relation
+ *	could be deferred.
+ *
+ **************************************/
+	SET_TDBB(tdbb);
+
+	// Triggers of the relation are requests on their own and would read
+	// the relation without the deferred keys
+
+	if ((transaction->tra_flags & TRA_system) ||
+		relation->isSystem() || relation->isTemporary() ||
+		relation->rel_pre_store || relation->rel_post_store ||
+		!tdbb->getDatabase()->dbb_config->getBulkIndexBuffer())
+	{
+		return NULL;
+	}
+
+	if (!transaction->tra_bulk_keys)
+		transaction->tra_bulk_keys = FB_NEW_POOL(*transaction->tra_pool) BulkIndexKeys(*transaction->tra_pool);
+
+	BulkIndexKeys* const bulkKeys = transaction->tra_bulk_keys;
+
+	return bulkKeys->isDeferrable(tdbb, relation) ? bulkKeys : NULL;
+}
+
+
 static PageNumber get_root_page(thread_db* tdbb, jrd_rel* relation)
 {
 /**************************************
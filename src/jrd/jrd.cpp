@@ -1871,6 +1871,8 @@ JAttachment* JProvider::internalAttach(CheckStatusWrapper* user_status, const ch
 				dbb->dbb_backup_manager->initializeAlloc(tdbb);
 				dbb->dbb_crypto_manager = FB_NEW_POOL(*dbb->dbb_permanent) CryptoManager(tdbb);
 				dbb->dbb_monitoring_data = FB_NEW_POOL(*dbb->dbb_permanent) MonitoringData(dbb);
+				dbb->dbb_shared_statements = FB_NEW_POOL(*dbb->dbb_permanent)
+					DsqlSharedStatementCache(*dbb->dbb_permanent, dbb);
 
 				PAG_init2(tdbb);
 				PAG_header(tdbb, false, newForceWrite);
@@ -2132,6 +2134,11 @@ JAttachment* JProvider::internalAttach(CheckStatusWrapper* user_status, const ch
 				AutoSetRestoreFlag<ULONG> noCleanup(&attachment->att_flags, ATT_no_cleanup, true);
 				VIO_fini(tdbb);
 
+				// Validation walks relations using parallel workers
+
+				if (options.dpb_parallel_workers)
+					attachment->att_parallel_workers = options.dpb_parallel_workers;
+
 				if (!VAL_validate(tdbb, options.dpb_verify))
 					ERR_punt();
 			}
@@ -3145,6 +3152,8 @@ JAttachment* JProvider::createDatabase(CheckStatusWrapper* user_status, const ch
 			dbb->dbb_backup_manager->dbCreating = true;
 			dbb->dbb_crypto_manager = FB_NEW_POOL(*dbb->dbb_permanent) CryptoManager(tdbb);
 			dbb->dbb_monitoring_data = FB_NEW_POOL(*dbb->dbb_permanent) MonitoringData(dbb);
+			dbb->dbb_shared_statements = FB_NEW_POOL(*dbb->dbb_permanent)
+				DsqlSharedStatementCache(*dbb->dbb_permanent, dbb);
 
 			PAG_format_header(tdbb);
 			PAG_format_pip(tdbb, *pageSpace);
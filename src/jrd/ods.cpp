@@ -150,7 +150,8 @@ Firebird::string pagtype(UCHAR type)
 		"index B-tree",
 		"blob",
 		"generators",
-		"SCN inventory"
+		"SCN inventory",
+		"block range index"
 	};
 
 	Firebird::string rc;
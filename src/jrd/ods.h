@@ -133,7 +133,9 @@ inline constexpr USHORT ODS_CURRENT13	= 1;
 // Minor versions for ODS 14
 
 inline constexpr USHORT ODS_CURRENT14_0	= 0;	// Firebird 6.0 features
-inline constexpr USHORT ODS_CURRENT14	= 0;
+inline constexpr USHORT ODS_CURRENT14_1	= 1;	// All-visible data pages, LZ compressed records and blobs,
+												// block range indices
+inline constexpr USHORT ODS_CURRENT14	= 1;
 
 // useful ODS macros. These are currently used to flag the version of the
 // system triggers and system indices in ini.e
@@ -156,6 +158,7 @@ inline constexpr USHORT ODS_12_0	= ENCODE_ODS(ODS_VERSION12, 0);
 inline constexpr USHORT ODS_13_0	= ENCODE_ODS(ODS_VERSION13, 0);
 inline constexpr USHORT ODS_13_1	= ENCODE_ODS(ODS_VERSION13, 1);
 inline constexpr USHORT ODS_14_0	= ENCODE_ODS(ODS_VERSION14, 0);
+inline constexpr USHORT ODS_14_1	= ENCODE_ODS(ODS_VERSION14, 1);
 
 inline constexpr USHORT ODS_FIREBIRD_FLAG = 0x8000;
 
@@ -204,7 +207,8 @@ inline constexpr SCHAR pag_index			= 7;		// Index (B-tree) page
 inline constexpr SCHAR pag_blob				= 8;		// Blob data page
 inline constexpr SCHAR pag_ids				= 9;		// Gen-ids
 inline constexpr SCHAR pag_scns				= 10;		// SCN's inventory page
-inline constexpr SCHAR pag_max				= 10;		// Max page type
+inline constexpr SCHAR pag_range			= 11;		// Block range index page (ODS 14.1)
+inline constexpr SCHAR pag_max				= 11;		// Max page type
 
 // Pre-defined page numbers
 
@@ -229,7 +233,7 @@ namespace Ods {
 inline constexpr bool pag_crypt_page[pag_max + 1] = {false, false, false,
 													 false, false, true,	// data
 													 false, true, true,		// index, blob
-													 true, false};			// generators
+													 true, false, true};	// generators, block ranges
 
 // pag_flags for any page type
 
@@ -326,6 +330,62 @@ static_assert(offsetof(struct btree_page, btr_nodes) == 39, "btr_nodes offset mi
 //const UCHAR btr_jump_info			= 16;	// AB: 2003-index-structure enhancement
 inline constexpr UCHAR btr_released			= 32;	// Page was released from b-tree
 
+
+// Block range index page. The index root points to the directory page
+// which lists the summary pages. Every summary page keeps the lowest and
+// the highest keys stored in the consecutive runs of RANGE_DATA_PAGES data
+// pages, the n-th run being summarized by the n-th summary in the index.
+
+struct range_page
+{
+	pag rng_header;
+	USHORT rng_relation;		// relation id for consistency
+	USHORT rng_id;				// index id for consistency
+	ULONG rng_sequence;			// sequence of the summary page in the directory
+	USHORT rng_key_length;		// maximum length of the summary keys
+	USHORT rng_count;			// number of summary pages (directory only)
+	ULONG rng_data[1];			// directory: summary page numbers, summary page: summaries
+};
+
+static_assert(sizeof(struct range_page) == 32, "struct range_page size mismatch");
+static_assert(offsetof(struct range_page, rng_header) == 0, "rng_header offset mismatch");
+static_assert(offsetof(struct range_page, rng_relation) == 16, "rng_relation offset mismatch");
+static_assert(offsetof(struct range_page, rng_id) == 18, "rng_id offset mismatch");
+static_assert(offsetof(struct range_page, rng_sequence) == 20, "rng_sequence offset mismatch");
+static_assert(offsetof(struct range_page, rng_key_length) == 24, "rng_key_length offset mismatch");
+static_assert(offsetof(struct range_page, rng_count) == 26, "rng_count offset mismatch");
+static_assert(offsetof(struct range_page, rng_data) == 28, "rng_data offset mismatch");
+
+#define RNG_SIZE static_cast<FB_SIZE_T>(offsetof(Ods::range_page, rng_data[0]))
+
+// pag_flags
+inline constexpr UCHAR rng_directory		= 0x01;		// Page lists the summary pages
+
+// Summary of a single block range
+
+struct range_summary
+{
+	USHORT rns_min_length;		// length of the lowest key, rns_empty if nothing is stored
+	USHORT rns_max_length;		// length of the highest key
+	UCHAR rns_data[1];			// lowest key followed by the highest key, rng_key_length each
+};
+
+static_assert(offsetof(struct range_summary, rns_data) == 4, "rns_data offset mismatch");
+
+#define RNS_SIZE static_cast<FB_SIZE_T>(offsetof(Ods::range_summary, rns_data[0]))
+
+inline constexpr USHORT rns_empty = 0xFFFF;
+
+// Number of data pages summarized together
+inline constexpr ULONG RANGE_DATA_PAGES = 128;
+
+inline FB_SIZE_T rangeSummaryLength(USHORT keyLength)
+{
+	// keep the summaries USHORT-aligned
+	const FB_SIZE_T length = RNS_SIZE + 2 * keyLength;
+	return length + (length & 1);
+}
+
 // Data Page
 
 struct data_page
@@ -361,6 +421,7 @@ inline constexpr UCHAR dpg_large		= 0x04;		// Large object is on page
 inline constexpr UCHAR dpg_swept		= 0x08;		// Sweep has nothing to do on this page
 inline constexpr UCHAR dpg_secondary	= 0x10;		// Primary record versions not stored on this page
 													// Set in dpm.epp's extend_relation() but never tested.
+inline constexpr UCHAR dpg_all_visible	= 0x20;		// Swept page with all records visible to every snapshot (ODS 14.1)
 
 
 // Index root page
@@ -436,6 +497,7 @@ inline constexpr USHORT irt_foreign			= 4;
 inline constexpr USHORT irt_primary			= 8;
 inline constexpr USHORT irt_expression		= 16;
 inline constexpr USHORT irt_condition		= 32;
+inline constexpr USHORT irt_block_range		= 128;	// ODS 14.1
 
 // possible index states
 inline constexpr UCHAR irt_unused		= 0;	// empty slot
@@ -709,6 +771,7 @@ inline constexpr UCHAR ppg_dp_large			= 0x02;		// Large object is on data page
 inline constexpr UCHAR ppg_dp_swept			= 0x04;		// Sweep has nothing to do on data page
 inline constexpr UCHAR ppg_dp_secondary		= 0x08;		// Primary record versions not stored on data page
 inline constexpr UCHAR ppg_dp_empty			= 0x10;		// Data page is empty
+inline constexpr UCHAR ppg_dp_all_visible	= 0x20;		// All records on data page are visible to every snapshot (ODS 14.1)
 
 inline constexpr UCHAR PPG_DP_ALL_BITS	= (1 << PPG_DP_BITS_NUM) - 1;
 
@@ -879,6 +942,7 @@ inline constexpr USHORT rhd_gc_active		= 256;		// garbage collecting dead record
 inline constexpr USHORT rhd_uk_modified		= 512;		// record key field values are changed
 inline constexpr USHORT rhd_long_tranum		= 1024;		// transaction number is 64-bit
 inline constexpr USHORT rhd_not_packed		= 2048;		// record (or delta) is stored "as is"
+inline constexpr USHORT rhd_lz_packed		= 4096;		// record (or delta) is LZ compressed (ODS 14.1)
 
 
 // This (not exact) copy of class DSC is used to store descriptors on disk.
@@ -231,7 +231,7 @@ void InnerJoin::estimateCost(unsigned position,
 			// probing + copying cost
 			cardinality * (COST_FACTOR_HASHING + currentCardinality * COST_FACTOR_MEMCOPY);
 
-		if (hashCost <= loopCost && hashCardinality <= HashJoin::maxCapacity())
+		if (hashCost <= loopCost && hashCardinality <= HashJoin::maxCapacity(tdbb))
 		{
 			auto& equiMatches = joinedStreams[position].equiMatches;
 			fb_assert(!equiMatches.hasData());
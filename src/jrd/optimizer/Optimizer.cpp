@@ -2378,6 +2378,63 @@ void Optimizer::formRivers(const StreamList& streams,
 }
 
 
+//
+// Check whether records of the given stream could be restored from the keys
+// of the index being scanned. This requires all the referenced fields to be
+// index segments whose keys could be decoded back and the record itself to
+// be neither locked, nor updated nor asked for its physical properties.
+//
+
+bool Optimizer::isIndexOnly(StreamType stream, const IndexRetrieval* retrieval) const
+{
+	const auto tail = &csb->csb_rpt[stream];
+
+	if ((tail->csb_flags & (csb_update | csb_record_version)) || rse->hasWriteLock())
+		return false;
+
+	// All-visible data pages exist since ODS 14.1 only. System relations are
+	// updated in place and their index keys are not cleaned up with the versions.
+	if (tdbb->getDatabase()->getEncodedOdsVersion() < ODS_14_1 ||
+		!tail->csb_relation || tail->csb_relation->isSystem())
+	{
+		return false;
+	}
+
+	if (retrieval->irb_generic & irb_skip_scan)
+		return false;
+
+	const auto idx = &retrieval->irb_desc;
+
+	if (!BTR_decodable_key(idx, CMP_format(tdbb, csb, stream)))
+		return false;
+
+	UInt32Bitmap::Accessor accessor(tail->csb_fields);
+
+	if (accessor.getFirst())
+	{
+		do
+		{
+			const auto id = accessor.current();
+			bool found = false;
+
+			for (USHORT i = 0; i < idx->idx_count; i++)
+			{
+				if (idx->idx_rpt[i].idx_field == id)
+				{
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+				return false;
+		} while (accessor.getNext());
+	}
+
+	return true;
+}
+
+
 //
 // We've got a set of rivers that may or may not be amenable to
 // a hash join or a sort/merge join, and it's time to find out.
@@ -2571,7 +2628,7 @@ bool Optimizer::generateEquiJoin(RiverList& rivers, JoinType joinType)
 			keys.back()->add(eq_class[position]);
 	}
 
-	const bool hashOverflow = (maxCardinality2 > HashJoin::maxCapacity());
+	const bool hashOverflow = (maxCardinality2 > HashJoin::maxCapacity(tdbb));
 
 	// If any of to-be-hashed rivers is too large to be hashed efficiently,
 	// then prefer a merge join instead of a hash join.
@@ -2793,6 +2850,9 @@ RecordSource* Optimizer::generateRetrieval(StreamType stream,
 
 			navigation->setInversion(inversion, condition);
 
+			if (isIndexOnly(stream, navigation->getIndex()->retrieval))
+				navigation->setIndexOnly();
+
 			rsb = navigation;
 		}
 	}
@@ -550,6 +550,7 @@ private:
 					SortNode** sortClause,
 					const PlanNode* planClause);
 	bool generateEquiJoin(RiverList& rivers, JoinType joinType = INNER_JOIN);
+	bool isIndexOnly(StreamType stream, const IndexRetrieval* retrieval) const;
 	void generateInnerJoin(StreamList& streams,
 						   RiverList& rivers,
 						   SortNode** sortClause,
@@ -642,6 +643,7 @@ struct IndexScratch
 	bool usePartialKey = false;					// Use INTL_KEY_PARTIAL
 	bool useMultiStartingKeys = false;			// Use INTL_KEY_MULTI_STARTING
 	bool useRootListScan = false;
+	bool useSkipScan = false;					// Leading segment is not matched
 
 	Firebird::ObjectsArray<IndexScratchSegment> segments;
 	BooleanList matches;					// matched booleans (partial indices only)
@@ -937,7 +939,12 @@ public:
 	RecordSource* generate();
 
 private:
-	RecordSource* process(StreamList* outerStreams = nullptr);
+	RecordSource* process(StreamList* outerStreams = nullptr, bool* fullJoined = nullptr);
+
+	bool isHashKey(BoolExprNode* boolean, const StreamList& outerStreams);
+	bool checkHashJoin(const StreamList& outerStreams);
+	RecordSource* generateHashJoin(const StreamList& outerStreams,
+								   BoolExprNode* boolean, bool fullJoin);
 
 	thread_db* const tdbb;
 	Optimizer* const optimizer;
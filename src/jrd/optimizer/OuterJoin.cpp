@@ -26,6 +26,8 @@
 #include "../jrd/jrd.h"
 #include "../jrd/cmp_proto.h"
 #include "../jrd/RecordSourceNodes.h"
+#include "../jrd/recsrc/RecordSource.h"
+#include "../dsql/BoolNodes.h"
 
 #include "../jrd/optimizer/Optimizer.h"
 
@@ -101,7 +103,14 @@ RecordSource* OuterJoin::generate()
 	}
 
 	StreamList outerStreams;
-	const auto outerJoinRsb = process(&outerStreams);
+	bool fullJoined = false;
+	const auto outerJoinRsb = process(&outerStreams, &fullJoined);
+
+	// The hash join may track the matched inner records itself,
+	// then it already produces the complete full outer join result
+
+	if (fullJoined)
+		return outerJoinRsb;
 
 	// A FULL JOIN B is currently implemented similar to:
 	//
@@ -154,7 +163,7 @@ RecordSource* OuterJoin::generate()
 }
 
 
-RecordSource* OuterJoin::process(StreamList* outerStreams)
+RecordSource* OuterJoin::process(StreamList* outerStreams, bool* fullJoined)
 {
 	BoolExprNode* boolean = nullptr;
 
@@ -187,8 +196,21 @@ RecordSource* OuterJoin::process(StreamList* outerStreams)
 		boolean = optimizer->composeBoolean();
 	}
 
+	StreamList streams;
+	outerStream.rsb->findUsedStreams(streams);
+
 	if (outerStreams)
-		outerStream.rsb->findUsedStreams(*outerStreams);
+		outerStreams->join(streams);
+
+	if (innerStream.number != INVALID_STREAM && checkHashJoin(streams))
+	{
+		const bool fullJoin = (fullJoined && optimizer->isFullJoin());
+
+		if (fullJoin)
+			*fullJoined = true;
+
+		return generateHashJoin(streams, boolean, fullJoin);
+	}
 
 	if (innerStream.number != INVALID_STREAM)
 	{
@@ -209,3 +231,189 @@ RecordSource* OuterJoin::process(StreamList* outerStreams)
 };
 
 
+// Check whether the given conjunct is an equality between the outer and inner expressions,
+// so that it can be used as a hash join key
+
+bool OuterJoin::isHashKey(BoolExprNode* boolean, const StreamList& outerStreams)
+{
+	if (!optimizer->checkEquiJoin(boolean))
+		return false;
+
+	const auto cmpNode = nodeAs<ComparativeBoolNode>(boolean);
+	fb_assert(cmpNode);
+
+	const auto innerNumber = joinStreams[1].number;
+	const auto arg1 = cmpNode->arg1;
+	const auto arg2 = cmpNode->arg2;
+
+	if (arg1->containsStream(innerNumber, true))
+		return arg2->containsAnyStream(outerStreams) && !arg2->containsStream(innerNumber);
+
+	if (arg2->containsStream(innerNumber, true))
+		return arg1->containsAnyStream(outerStreams) && !arg1->containsStream(innerNumber);
+
+	return false;
+}
+
+
+// Check whether the inner stream can be hash joined to the outer one
+// and whether it's expected to be cheaper than the nested loop join
+
+bool OuterJoin::checkHashJoin(const StreamList& outerStreams)
+{
+	const auto innerNumber = joinStreams[1].number;
+	fb_assert(innerNumber != INVALID_STREAM);
+
+	// At least one equality between the outer and inner streams is required.
+	// Booleans that must remain residual cannot be moved into the hash join.
+	// A full join cannot filter the inner stream before hashing it,
+	// as the filtered out inner records must be returned too.
+
+	bool hasKeys = false;
+
+	for (auto iter = optimizer->getConjuncts(false, true); iter.hasData(); ++iter)
+	{
+		if ((iter & Optimizer::CONJUNCT_USED) || !iter->containsStream(innerNumber))
+			continue;
+
+		if (iter->nodFlags & ExprNode::FLAG_RESIDUAL)
+			return false;
+
+		if (optimizer->isFullJoin() && iter->containsStream(innerNumber, true))
+			return false;
+
+		if (isHashKey(iter, outerStreams))
+			hasKeys = true;
+	}
+
+	if (!hasKeys)
+		return false;
+
+	const auto tail = &csb->csb_rpt[innerNumber];
+	const auto streamCardinality = tail->csb_cardinality;
+	const auto outerCardinality = joinStreams[0].rsb->getCardinality();
+
+	tail->activate();
+
+	// Estimate the inner stream retrieval being independent from the outer streams
+
+	double baseCost, baseSelectivity;
+	bool avoidHashJoin;
+
+	{
+		StreamStateHolder stateHolder(csb, outerStreams);
+		stateHolder.deactivate();
+
+		Retrieval retrieval(tdbb, optimizer, innerNumber, false, true, nullptr, true);
+		const auto candidate = retrieval.getInversion();
+
+		baseCost = candidate->cost;
+		baseSelectivity = candidate->selectivity;
+
+		// See InnerJoin::estimateCost() for the reasons
+		avoidHashJoin = (streamCardinality <= MINIMUM_CARDINALITY && !candidate->indexes);
+	}
+
+	// Estimate the inner stream retrieval for every outer record (nested loop join)
+
+	Retrieval retrieval(tdbb, optimizer, innerNumber, false, true, nullptr, true);
+	const auto candidate = retrieval.getInversion();
+
+	tail->deactivate();
+
+	if (avoidHashJoin)
+		return false;
+
+	const auto loopCost = candidate->cost * outerCardinality;
+	const auto matchCardinality = candidate->unique ?
+		MINIMUM_CARDINALITY : streamCardinality * candidate->selectivity;
+
+	const auto hashCardinality = streamCardinality * baseSelectivity;
+	const auto hashCost = baseCost +
+		// hashing cost
+		hashCardinality * (COST_FACTOR_MEMCOPY + COST_FACTOR_HASHING) +
+		// probing + copying cost
+		outerCardinality * (COST_FACTOR_HASHING + matchCardinality * COST_FACTOR_MEMCOPY);
+
+	return (hashCost <= loopCost && hashCardinality <= HashJoin::maxCapacity(tdbb));
+}
+
+
+// Generate a hash join between the outer and inner streams
+
+RecordSource* OuterJoin::generateHashJoin(const StreamList& outerStreams,
+										  BoolExprNode* boolean, bool fullJoin)
+{
+	auto& outerStream = joinStreams[0];
+	auto& innerStream = joinStreams[1];
+
+	fb_assert(!innerStream.rsb);
+
+	// The inner stream is read and hashed just once,
+	// so it must not depend on the outer streams
+
+	{
+		StreamStateHolder stateHolder(csb, outerStreams);
+		stateHolder.deactivate();
+
+		innerStream.rsb = optimizer->generateRetrieval(innerStream.number, nullptr, false, true);
+	}
+
+	// Collect the hash keys and compose the join condition. The latter one
+	// is re-checked for every matching inner record, as hash values may collide
+	// and the join condition may be not limited to the equalities.
+	// All the remaining base conjuncts are included, as the nested loop join
+	// would have applied them to the inner stream (see applyResidualBoolean).
+
+	const auto outerKeys = FB_NEW_POOL(getPool()) NestValueArray(getPool());
+	const auto innerKeys = FB_NEW_POOL(getPool()) NestValueArray(getPool());
+	BoolExprNode* matchBoolean = nullptr;
+
+	const auto collectConjunct = [&](Optimizer::ConjunctIterator& iter)
+	{
+		if (isHashKey(iter, outerStreams))
+		{
+			NestConst<ValueExprNode> node1;
+			NestConst<ValueExprNode> node2;
+
+			if (!optimizer->getEquiJoinKeys(iter, &node1, &node2))
+				fb_assert(false);
+
+			if (node1->containsStream(innerStream.number))
+				std::swap(node1, node2);
+
+			outerKeys->add(node1);
+			innerKeys->add(node2);
+		}
+
+		matchBoolean = matchBoolean ?
+			FB_NEW_POOL(getPool()) BinaryBoolNode(getPool(), blr_and, matchBoolean, iter) :
+			(BoolExprNode*) iter;
+
+		iter |= Optimizer::CONJUNCT_USED;
+	};
+
+	for (auto iter = optimizer->getBaseConjuncts(); iter.hasData(); ++iter)
+	{
+		if (!(iter & Optimizer::CONJUNCT_USED))
+			collectConjunct(iter);
+	}
+
+	for (auto iter = optimizer->getConjuncts(false, true); iter.hasData(); ++iter)
+	{
+		if (!(iter & Optimizer::CONJUNCT_USED) &&
+			iter->containsStream(innerStream.number) &&
+			iter->computable(csb, INVALID_STREAM, false))
+		{
+			collectConjunct(iter);
+		}
+	}
+
+	fb_assert(outerKeys->hasData());
+
+	RecordSource* const rsbs[] = {outerStream.rsb, innerStream.rsb};
+	NestValueArray* const keys[] = {outerKeys, innerKeys};
+
+	return FB_NEW_POOL(getPool())
+		HashJoin(tdbb, csb, boolean, matchBoolean, rsbs, keys, fullJoin);
+}
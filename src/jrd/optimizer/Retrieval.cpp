@@ -132,6 +132,7 @@ IndexScratch::IndexScratch(MemoryPool& p, const IndexScratch& other)
 	  usePartialKey(other.usePartialKey),
 	  useMultiStartingKeys(other.useMultiStartingKeys),
 	  useRootListScan(other.useRootListScan),
+	  useSkipScan(other.useSkipScan),
 	  segments(p, other.segments),
 	  matches(p, other.matches)
 {}
@@ -188,6 +189,16 @@ Retrieval::Retrieval(thread_db* aTdbb, Optimizer* opt, StreamType streamNumber,
 		double cardinality = tail->csb_cardinality * index.idx_fraction;
 		cardinality *= (2 + length * factor);
 		cardinality /= (dbb->dbb_page_size - BTR_SIZE);
+
+		if (index.idx_flags & idx_block_range)
+		{
+			// Block range index is read as a whole, its size depends
+			// on the number of data pages rather than on the records
+			const double dataPages = relation->getPages(tdbb)->rel_data_pages;
+			cardinality = dataPages / Ods::RANGE_DATA_PAGES *
+				Ods::rangeSummaryLength(length) / (dbb->dbb_page_size - RNG_SIZE);
+		}
+
 		cardinality = MAX(cardinality, MINIMUM_CARDINALITY);
 
 		IndexScratch scratch(getPool(), &index);
@@ -461,6 +472,16 @@ IndexTableScan* Retrieval::getNavigation(const InversionCandidate* candidate)
 		}
 	}
 
+	// Skip scan is not usable for navigation, walk the whole index instead
+	if (scratch->useSkipScan)
+	{
+		scratch->useSkipScan = false;
+		scratch->lowerCount = 0;
+		scratch->upperCount = 0;
+		scratch->usePartialKey = false;
+		scratch->useMultiStartingKeys = false;
+	}
+
 	// Looks like we can do a navigational walk.  Flag that
 	// we have used this index for navigation, and allocate
 	// a navigational rsb for it.
@@ -511,6 +532,10 @@ void Retrieval::analyzeNavigation(const InversionCandidateList& inversions)
 				continue;
 		}
 
+		// block range index keeps no order of the records
+		if (idx->idx_flags & idx_block_range)
+			continue;
+
 		// check to see if the fields in the sort match the fields in the index
 		// in the exact same order
 
@@ -525,6 +550,8 @@ void Retrieval::analyzeNavigation(const InversionCandidateList& inversions)
 			{
 				equalSegments++;
 			}
+			else
+				break;
 		}
 
 		bool usableIndex = true;
@@ -638,13 +665,15 @@ void Retrieval::analyzeNavigation(const InversionCandidateList& inversions)
 		if (!usableIndex)
 			continue;
 
-		// Lookup the inversion candidate matching our navigational index
+		// Lookup the inversion candidate matching our navigational index.
+		// Skip scan candidate cannot be used for navigation, so treat
+		// the navigational index as not matched in this case.
 
 		InversionCandidate* candidate = nullptr;
 
 		for (const auto inversion : inversions)
 		{
-			if (inversion->scratch == &indexScratch)
+			if (inversion->scratch == &indexScratch && !indexScratch.useSkipScan)
 			{
 				candidate = inversion;
 				break;
@@ -933,7 +962,16 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 
 		const auto idx = scratch.index;
 
-		if (scratch.candidate)
+		// If the leading segment is not matched but the next one is, the index
+		// could still be probed once per every distinct value of the leading segment.
+		// This requires the leading segment statistics to be known.
+		scratch.useSkipScan = !scratch.candidate && idx->idx_count > 1 &&
+			scratch.segments[1].scanType != segmentScanNone &&
+			scratch.segments[1].scanType != segmentScanList &&
+			idx->idx_rpt[0].idx_selectivity > 0 &&
+			!(idx->idx_flags & (idx_descending | idx_condition | idx_expression | idx_block_range));
+
+		if (scratch.candidate || scratch.useSkipScan)
 		{
 			matches.assign(scratch.matches);
 			scratch.selectivity = MAXIMUM_SELECTIVITY;
@@ -941,6 +979,7 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 			bool unique = false;
 			unsigned listCount = 0;
 			auto maxSelectivity = scratch.selectivity;
+			double skipScanCost = 0;
 
 			for (unsigned j = 0; j < scratch.segments.getCount(); j++)
 			{
@@ -951,6 +990,14 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 				if (segment.scope == scope)
 					scratch.scopeCandidate = true;
 
+				if (j == 0 && scratch.useSkipScan)
+				{
+					// The leading segment matches any value
+					scratch.lowerCount++;
+					scratch.upperCount++;
+					continue;
+				}
+
 				const USHORT iType = idx->idx_rpt[j].idx_itype;
 
 				if (iType >= idx_first_intl_string)
@@ -985,6 +1032,12 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 				// match to represent 1/10 of the maximum selectivity.
 				if (useDefaultSelectivity)
 					selectivity = MAX(scratch.selectivity * DEFAULT_SELECTIVITY, minSelectivity);
+				else if (scratch.useSkipScan)
+				{
+					// Exclude the leading segment from the compound selectivity
+					selectivity /= idx->idx_rpt[0].idx_selectivity;
+					selectivity = MIN(selectivity, MAXIMUM_SELECTIVITY);
+				}
 
 				if (scanType == segmentScanList)
 				{
@@ -1022,7 +1075,7 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 						(scanType == segmentScanEquivalent && (idx->idx_flags & idx_primary)) ||
 						(scanType == segmentScanMissing && (idx->idx_flags & idx_primary));
 
-					if (uniqueMatch && ((j + 1) == idx->idx_count))
+					if (uniqueMatch && !scratch.useSkipScan && ((j + 1) == idx->idx_count))
 					{
 						// We have found a full equal matching index and it's unique,
 						// so we can stop looking further, because this is the best
@@ -1099,13 +1152,34 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 				}
 			}
 
+			if (scratch.useSkipScan)
+			{
+				// Every distinct value of the leading segment costs two extra lookups
+				// from the root: to find the value itself and then to find the range
+				// of the trailing segments. Don't bother if walking the whole index
+				// is cheaper or the trailing segments cannot be scanned this way.
+				const double leadingCount = MAXIMUM_SELECTIVITY / idx->idx_rpt[0].idx_selectivity;
+				skipScanCost = 2 * DEFAULT_INDEX_COST * leadingCount;
+
+				if (listCount || scratch.useMultiStartingKeys ||
+					MAX(scratch.lowerCount, scratch.upperCount) < 2 ||
+					skipScanCost + scratch.selectivity * scratch.cardinality >= scratch.cardinality)
+				{
+					scratch.useSkipScan = false;
+					scratch.scopeCandidate = false;
+					scratch.lowerCount = 0;
+					scratch.upperCount = 0;
+					scratch.nonFullMatchedSegments = MAX_INDEX_SEGMENTS + 1;
+				}
+			}
+
 			if (scratch.scopeCandidate)
 			{
 				double selectivity = scratch.selectivity;
 				fb_assert(selectivity);
 
 				// Calculate the cost (only index pages) for this index
-				auto cost = DEFAULT_INDEX_COST + selectivity * scratch.cardinality;
+				auto cost = DEFAULT_INDEX_COST + skipScanCost + selectivity * scratch.cardinality;
 
 				if (listCount)
 				{
@@ -1126,6 +1200,18 @@ void Retrieval::getInversionCandidates(InversionCandidateList& inversions,
 						cost = siblingScanCost;
 				}
 
+				if (idx->idx_flags & idx_block_range)
+				{
+					// All the summaries are read at once for any lookup and the
+					// matching records are returned by whole runs of data pages
+					const double dataPages = MAX(relation->getPages(tdbb)->rel_data_pages, 1);
+
+					cost = DEFAULT_INDEX_COST + scratch.cardinality;
+					selectivity = MAX(selectivity, Ods::RANGE_DATA_PAGES / dataPages);
+					selectivity = MIN(selectivity, MAXIMUM_SELECTIVITY);
+					unique = false;
+				}
+
 				const auto invCandidate = FB_NEW_POOL(getPool()) InversionCandidate(getPool());
 				invCandidate->unique = unique;
 				invCandidate->selectivity = idx->idx_fraction * selectivity;
@@ -1330,6 +1416,12 @@ InversionNode* Retrieval::makeIndexScanNode(IndexScratch* indexScratch) const
 		retrieval->irb_generic |= irb_root_list_scan;
 	}
 
+	if (indexScratch->useSkipScan)
+	{
+		fb_assert(!retrieval->irb_list && !(idx->idx_runtime_flags & idx_navigate));
+		retrieval->irb_generic |= irb_skip_scan;
+	}
+
 	// Check to see if this is really an equality retrieval
 	if (retrieval->irb_lower_count == retrieval->irb_upper_count)
 	{
@@ -1359,7 +1451,7 @@ InversionNode* Retrieval::makeIndexScanNode(IndexScratch* indexScratch) const
 			}
 		}
 
-		if ((retrieval->irb_generic & irb_equality) && uniqueMatch)
+		if ((retrieval->irb_generic & irb_equality) && uniqueMatch && !indexScratch->useSkipScan)
 			retrieval->irb_generic |= irb_unique;
 	}
 
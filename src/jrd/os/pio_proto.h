@@ -48,6 +48,7 @@ bool	PIO_header(Jrd::thread_db*, UCHAR*, unsigned);
 USHORT	PIO_init_data(Jrd::thread_db*, Jrd::jrd_file*, Jrd::FbStatusVector*, ULONG, USHORT);
 Jrd::jrd_file*	PIO_open(Jrd::thread_db*, const Firebird::PathName&,
 						 const Firebird::PathName&);
+void	PIO_prefetch(Jrd::thread_db*, Jrd::jrd_file*, ULONG, ULONG);
 bool	PIO_read(Jrd::thread_db*, Jrd::jrd_file*, Jrd::BufferDesc*, Ods::pag*, Jrd::FbStatusVector*);
 
 #ifdef SUPERSERVER_V2
@@ -66,6 +67,8 @@ inline bool PIO_on_raw_device(const Firebird::PathName&)
 }
 #endif
 bool	PIO_write(Jrd::thread_db*, Jrd::jrd_file*, Jrd::BufferDesc*, Ods::pag*, Jrd::FbStatusVector*);
+bool	PIO_write_pages(Jrd::thread_db*, Jrd::jrd_file*, Jrd::BufferDesc* const*, Ods::pag* const*,
+						FB_SIZE_T, Jrd::FbStatusVector*);
 
 #endif // JRD_PIO_PROTO_H
 
@@ -48,6 +48,10 @@
 #ifdef HAVE_LINUX_FALLOC_H
 #include <linux/falloc.h>
 #endif
+#ifdef HAVE_PWRITEV
+#include <sys/uio.h>
+#include <limits.h>
+#endif
 
 #ifdef SUPPORT_RAW_DEVICES
 #include <sys/ioctl.h>
@@ -90,6 +94,10 @@ using namespace Firebird;
 
 #define IO_RETRY	20
 
+#if defined(HAVE_PWRITEV) && !defined(IOV_MAX)
+#define IOV_MAX		1024
+#endif
+
 #ifdef O_SYNC
 #define SYNC		O_SYNC
 #endif
@@ -740,6 +748,43 @@ jrd_file* PIO_open(thread_db* tdbb,
 }
 
 
+void PIO_prefetch(thread_db* tdbb, jrd_file* file, ULONG startPage, ULONG pageCount)
+{
+/**************************************
+ *
+ *	P I O _ p r e f e t c h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Ask the OS to start reading a run of pages asynchronously,
+ *	so they are already in the file system cache when fetched.
+ *	Nothing is done if the file system cache is not used, such
+ *	files are read ahead into the page cache by the cache writer,
+ *	see CCH_read_ahead.
+ *
+ **************************************/
+#ifdef POSIX_FADV_WILLNEED
+	if (file->fil_desc == -1 || (file->fil_flags & FIL_no_fs_cache) || !pageCount)
+		return;
+
+	Database* const dbb = tdbb->getDatabase();
+
+	const FB_UINT64 offset = (FB_UINT64) startPage * dbb->dbb_page_size;
+	const FB_UINT64 length = (FB_UINT64) pageCount * dbb->dbb_page_size;
+
+	if (offset != (FB_UINT64) LSEEK_OFFSET_CAST offset)
+		return;
+
+	EngineCheckout cout(tdbb, FB_FUNCTION, EngineCheckout::UNNECESSARY);
+
+	// It's just a hint, so errors are ignored
+	os_utils::posix_fadvise(file->fil_desc, LSEEK_OFFSET_CAST offset, LSEEK_OFFSET_CAST length,
+		POSIX_FADV_WILLNEED);
+#endif
+}
+
+
 bool PIO_read(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page, FbStatusVector* status_vector)
 {
 /**************************************
@@ -836,6 +881,77 @@ bool PIO_write(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page,
 }
 
 
+bool PIO_write_pages(thread_db* tdbb, jrd_file* file, BufferDesc* const* bdbs, Ods::pag* const* pages,
+	FB_SIZE_T count, FbStatusVector* status_vector)
+{
+/**************************************
+ *
+ *	P I O _ w r i t e _ p a g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Write a run of adjacent pages, given in ascending
+ *	order, using a single vectored write if possible.
+ *
+ **************************************/
+#ifdef HAVE_PWRITEV
+	if (file->fil_desc == -1)
+		return unix_error("write", file, isc_io_write_err, status_vector);
+
+	Database* const dbb = tdbb->getDatabase();
+	const SLONG size = dbb->dbb_page_size;
+
+	FB_UINT64 offset;
+	if (!seek_file(file, bdbs[0], &offset, status_vector))
+		return false;
+
+	HalfStaticArray<iovec, 64> iov;
+	iovec* const vector = iov.getBuffer(count);
+
+	for (FB_SIZE_T n = 0; n < count; n++)
+	{
+		vector[n].iov_base = pages[n];
+		vector[n].iov_len = size;
+	}
+
+	EngineCheckout cout(tdbb, FB_FUNCTION, EngineCheckout::UNNECESSARY);
+
+	FB_SIZE_T done = 0;
+	int retries = 0;
+
+	while (done < count)
+	{
+		const int chunk = (int) MIN(count - done, (FB_SIZE_T) IOV_MAX);
+		const SINT64 bytes = pwritev(file->fil_desc, vector + done, chunk,
+			LSEEK_OFFSET_CAST (offset + (FB_UINT64) done * size));
+
+		if (bytes < 0 && !SYSCALL_INTERRUPTED(errno))
+			return unix_error("write", file, isc_io_write_err, status_vector);
+
+		// Partially written page is written again with the rest of the run
+
+		const FB_SIZE_T written = bytes > 0 ? (FB_SIZE_T) (bytes / size) : 0;
+
+		if (written)
+			done += written;
+		else if (++retries >= IO_RETRY)
+			return unix_error("write_retry", file, isc_io_write_err, status_vector);
+	}
+
+	return true;
+#else
+	for (FB_SIZE_T n = 0; n < count; n++)
+	{
+		if (!PIO_write(tdbb, file, bdbs[n], pages[n], status_vector))
+			return false;
+	}
+
+	return true;
+#endif
+}
+
+
 static bool seek_file(jrd_file* file, BufferDesc* bdb, FB_UINT64* offset,
 					  FbStatusVector* status_vector)
 {
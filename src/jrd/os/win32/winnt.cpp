@@ -525,6 +525,22 @@ jrd_file* PIO_open(thread_db* tdbb,
 }
 
 
+void PIO_prefetch(thread_db* tdbb, jrd_file* file, ULONG startPage, ULONG pageCount)
+{
+/**************************************
+ *
+ *	P I O _ p r e f e t c h
+ *
+ **************************************
+ *
+ * Functional description
+ *	Read-ahead hint. Not implemented on Windows, the OS
+ *	detects sequential reads by itself.
+ *
+ **************************************/
+}
+
+
 bool PIO_read(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page, FbStatusVector* status_vector)
 {
 /**************************************
@@ -725,6 +741,31 @@ bool PIO_write(thread_db* tdbb, jrd_file* file, BufferDesc* bdb, Ods::pag* page,
 }
 
 
+bool PIO_write_pages(thread_db* tdbb, jrd_file* file, BufferDesc* const* bdbs, Ods::pag* const* pages,
+	FB_SIZE_T count, FbStatusVector* status_vector)
+{
+/**************************************
+ *
+ *	P I O _ w r i t e _ p a g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Write a run of adjacent pages. Pages are written
+ *	one by one as WriteFileGather() requires unbuffered
+ *	I/O with system page sized buffers.
+ *
+ **************************************/
+	for (FB_SIZE_T n = 0; n < count; n++)
+	{
+		if (!PIO_write(tdbb, file, bdbs[n], pages[n], status_vector))
+			return false;
+	}
+
+	return true;
+}
+
+
 ULONG PIO_get_number_of_pages(const jrd_file* file, const USHORT pagesize)
 {
 /**************************************
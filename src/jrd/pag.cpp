@@ -1205,8 +1205,10 @@ void PAG_init(thread_db* tdbb)
 	// can overlap prefetch I/O with database computation over previously prefetched pages.
 #ifdef SUPERSERVER_V2
 	dbb->dbb_prefetch_sequence = PREFETCH_MAX_TRANSFER / dbb->dbb_page_size;
-	dbb->dbb_prefetch_pages = dbb->dbb_prefetch_sequence * 2;
+#else
+	dbb->dbb_prefetch_sequence = READ_AHEAD_TRANSFER / dbb->dbb_page_size;
 #endif
+	dbb->dbb_prefetch_pages = dbb->dbb_prefetch_sequence * 2;
 }
 
 
@@ -21,6 +21,7 @@
 #include "../jrd/jrd.h"
 #include "../dsql/Nodes.h"
 #include "../dsql/ExprNodes.h"
+#include "../dsql/AggNodes.h"
 #include "../jrd/cmp_proto.h"
 #include "../jrd/evl_proto.h"
 #include "../jrd/exe_proto.h"
@@ -376,9 +377,24 @@ template class Jrd::BaseAggWinStream<WindowedStream::WindowStream, BaseBufferedS
 
 AggregatedStream::AggregatedStream(thread_db* tdbb, CompilerScratch* csb, StreamType stream,
 			const NestValueArray* group, MapNode* map, RecordSource* next)
-	: BaseAggWinStream(tdbb, csb, stream, group, map, !group, next)
+	: BaseAggWinStream(tdbb, csb, stream, group, map, !group, next),
+	  m_countOnly(!group)
 {
 	fb_assert(map);
+
+	// Check whether the map consists of plain COUNT(*) aggregates only,
+	// so the result can be requested from the underlying stream at once
+
+	for (const auto& source : map->sourceList)
+	{
+		const auto countNode = nodeAs<CountAggNode>(source);
+
+		if (!(countNode && !countNode->arg && !countNode->distinct) && !nodeIs<LiteralNode>(source))
+		{
+			m_countOnly = false;
+			break;
+		}
+	}
 }
 
 void AggregatedStream::getLegacyPlan(thread_db* tdbb, string& plan, unsigned level) const
@@ -414,6 +430,12 @@ bool AggregatedStream::internalGetRecord(thread_db* tdbb) const
 		return false;
 	}
 
+	if (m_countOnly && impure->state == STATE_GROUPING && evaluateCount(tdbb))
+	{
+		rpb->rpb_number.setValid(true);
+		return true;
+	}
+
 	if (!evaluateGroup(tdbb))
 	{
 		rpb->rpb_number.setValid(false);
@@ -423,3 +445,36 @@ bool AggregatedStream::internalGetRecord(thread_db* tdbb) const
 	rpb->rpb_number.setValid(true);
 	return true;
 }
+
+// Compute COUNT(*) aggregates using the record count reported by the underlying stream
+bool AggregatedStream::evaluateCount(thread_db* tdbb) const
+{
+	Request* const request = tdbb->getRequest();
+	Impure* const impure = getImpure(request);
+
+	SINT64 count;
+
+	if (!m_next->countRecords(tdbb, count))
+		return false;
+
+	aggInit(tdbb, request, m_groupMap);
+
+	try
+	{
+		for (const auto& source : m_groupMap->sourceList)
+		{
+			if (const auto countNode = nodeAs<CountAggNode>(source))
+				countNode->aggPassCount(request, count);
+		}
+
+		aggExecute(tdbb, request, m_groupMap->sourceList, m_groupMap->targetList);
+	}
+	catch (const Exception&)
+	{
+		aggFinish(tdbb, request, m_groupMap);
+		throw;
+	}
+
+	impure->state = STATE_EOF;
+	return true;
+}
@@ -22,6 +22,7 @@
 #include "../jrd/btr.h"
 #include "../jrd/req.h"
 #include "../jrd/cmp_proto.h"
+#include "../jrd/dpm_proto.h"
 #include "../jrd/evl_proto.h"
 #include "../jrd/vio_proto.h"
 #include "../jrd/rlck_proto.h"
@@ -54,6 +55,7 @@ void BitmapTableScan::internalOpen(thread_db* tdbb) const
 
 	impure->irsb_flags = irsb_open;
 	impure->irsb_bitmap = EVL_bitmap(tdbb, m_inversion, NULL);
+	impure->irsb_read_ahead = 0;
 
 	record_param* const rpb = &request->req_rpb[m_stream];
 	RLCK_reserve_relation(tdbb, request->req_transaction, m_relation, false);
@@ -110,6 +112,12 @@ bool BitmapTableScan::internalGetRecord(thread_db* tdbb) const
 		{
 			rpb->rpb_number.setValue(bitmap->current());
 
+			if (rpb->rpb_number.getValue() >= impure->irsb_read_ahead)
+			{
+				impure->irsb_read_ahead =
+					DPM_read_ahead(tdbb, m_relation, bitmap, rpb->rpb_number.getValue());
+			}
+
 			if (VIO_get(tdbb, rpb, request->req_transaction, request->req_pool))
 			{
 				rpb->rpb_number.setValid(true);
@@ -20,18 +20,302 @@
 #include "firebird.h"
 #include "../jrd/jrd.h"
 #include "../jrd/req.h"
+#include "../jrd/tra.h"
 #include "../jrd/cmp_proto.h"
 #include "../jrd/dpm_proto.h"
+#include "../jrd/err_proto.h"
 #include "../jrd/evl_proto.h"
+#include "../jrd/met_proto.h"
+#include "../jrd/tra_proto.h"
 #include "../jrd/vio_proto.h"
 #include "../jrd/rlck_proto.h"
 #include "../jrd/Attachment.h"
+#include "../jrd/WorkerAttachment.h"
+#include "../common/Task.h"
+#include "../common/classes/ClumpletWriter.h"
 
 #include "RecordSource.h"
 
 using namespace Firebird;
 using namespace Jrd;
 
+namespace
+{
+	// Counts the records of a relation visible in the given snapshot. Pointer
+	// pages are handed out to the workers one by one, every worker reads them
+	// using its own attachment and a read-only transaction that shares the snapshot.
+
+	class ScanCountTask : public Task
+	{
+	public:
+		ScanCountTask(thread_db* tdbb, MemoryPool* pool, const jrd_rel* relation,
+					  ULONG countPP, CommitNumber snapshot, int workers)
+			: m_pool(pool),
+			  m_dbb(tdbb->getDatabase()),
+			  m_relationId(relation->rel_id),
+			  m_relationName(relation->rel_name),
+			  m_snapshot(snapshot),
+			  m_countPP(countPP),
+			  m_nextPP(0),
+			  m_items(*pool),
+			  m_count(0),
+			  m_stop(false)
+		{
+			for (int i = 0; i < workers; i++)
+				m_items.add(FB_NEW_POOL(*m_pool) Item(this));
+		}
+
+		~ScanCountTask()
+		{
+			for (Item** p = m_items.begin(); p < m_items.end(); p++)
+				delete *p;
+		}
+
+		class Item : public Task::WorkItem
+		{
+		public:
+			explicit Item(ScanCountTask* task)
+				: Task::WorkItem(task),
+				  m_inuse(false),
+				  m_tra(nullptr),
+				  m_pp(0)
+			{}
+
+			~Item()
+			{
+				if (!m_attStable)
+					return;
+
+				Attachment* att = nullptr;
+				{
+					AttSyncLockGuard guard(*m_attStable->getSync(), FB_FUNCTION);
+
+					att = m_attStable->getHandle();
+					if (!att)
+						return;
+					fb_assert(att->att_use_count > 0);
+				}
+
+				FbLocalStatus status;
+				if (m_tra)
+				{
+					BackgroundContextHolder tdbb(att->att_database, att, &status, FB_FUNCTION);
+					TRA_commit(tdbb, m_tra, false);
+				}
+				WorkerAttachment::releaseAttachment(&status, m_attStable);
+			}
+
+			bool init(thread_db* tdbb);
+
+			ScanCountTask* getTask() const
+			{
+				return static_cast<ScanCountTask*>(m_task);
+			}
+
+			bool m_inuse;
+			RefPtr<StableAttachmentPart> m_attStable;
+			jrd_tra* m_tra;
+			ULONG m_pp;				// pointer page to scan
+		};
+
+		bool handler(WorkItem& _item) override;
+		bool getWorkItem(WorkItem** pItem) override;
+		bool getResult(IStatus* status) override;
+
+		int getMaxWorkers() override
+		{
+			return (int) MIN(m_items.getCount(), m_countPP);
+		}
+
+		SINT64 getCount() const
+		{
+			return m_count;
+		}
+
+	private:
+		void setError(IStatus* status)
+		{
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			if (m_status.isSuccess())
+				m_status.save(status);
+
+			m_stop = true;
+		}
+
+		MemoryPool* const m_pool;
+		Database* const m_dbb;
+		const USHORT m_relationId;
+		const MetaName m_relationName;
+		const CommitNumber m_snapshot;
+		const ULONG m_countPP;
+		ULONG m_nextPP;
+
+		Mutex m_mutex;
+		HalfStaticArray<Item*, 8> m_items;
+		StatusHolder m_status;
+		std::atomic<SINT64> m_count;
+		volatile bool m_stop;
+	};
+
+	bool ScanCountTask::Item::init(thread_db* tdbb)
+	{
+		FbStatusVector* const status = tdbb->tdbb_status_vector;
+		ScanCountTask* const task = getTask();
+
+		if (!m_attStable.hasData())
+			m_attStable = WorkerAttachment::getAttachment(status, task->m_dbb);
+
+		Attachment* const att = m_attStable ? m_attStable->getHandle() : nullptr;
+
+		if (!att)
+		{
+			if (!status->hasData())
+				Arg::Gds(isc_bad_db_handle).copyTo(status);
+
+			return false;
+		}
+
+		tdbb->setDatabase(att->att_database);
+		tdbb->setAttachment(att);
+
+		if (!m_tra)
+		{
+			ClumpletWriter tpb(ClumpletReader::Tpb, 64, isc_tpb_version3);
+			tpb.insertTag(isc_tpb_concurrency);
+			tpb.insertTag(isc_tpb_read);
+			tpb.insertBigInt(isc_tpb_at_snapshot_number, task->m_snapshot);
+
+			try
+			{
+				WorkerContextHolder holder(tdbb, FB_FUNCTION);
+				m_tra = TRA_start(tdbb, tpb.getBufferLength(), tpb.getBuffer());
+			}
+			catch (const Exception& ex)
+			{
+				ex.stuffException(status);
+				return false;
+			}
+		}
+
+		tdbb->setTransaction(m_tra);
+
+		return true;
+	}
+
+	bool ScanCountTask::handler(WorkItem& _item)
+	{
+		Item* const item = static_cast<Item*>(&_item);
+
+		ThreadContextHolder tdbb(NULL);
+
+		if (!item->init(tdbb))
+		{
+			setError(tdbb->tdbb_status_vector);
+			return false;
+		}
+
+		WorkerContextHolder holder(tdbb, FB_FUNCTION);
+
+		record_param rpb;
+		jrd_rel* relation = nullptr;
+
+		try
+		{
+			Database* const dbb = tdbb->getDatabase();
+
+			relation = MET_lookup_relation_id(tdbb, m_relationId, false);
+
+			if (!relation || (relation->rel_flags & (REL_deleted | REL_deleting)))
+				ERR_post(Arg::Gds(isc_relnotdef) << Arg::Str(m_relationName));
+
+			rpb.rpb_relation = relation;
+			rpb.rpb_record = nullptr;
+			rpb.rpb_stream_flags = RPB_s_no_data;
+			rpb.rpb_org_scans = relation->rel_scan_count++;
+			rpb.getWindow(tdbb).win_flags = WIN_large_scan;
+
+			rpb.rpb_number.compose(dbb->dbb_max_records, dbb->dbb_dp_per_pp, 0, 0, item->m_pp);
+			rpb.rpb_number.decrement();
+
+			RecordNumber lastRecNo;
+			lastRecNo.compose(dbb->dbb_max_records, dbb->dbb_dp_per_pp, 0, 0, item->m_pp + 1);
+			lastRecNo.decrement();
+
+			SINT64 count = 0;
+
+			while (!m_stop &&
+				VIO_next_record(tdbb, &rpb, item->m_tra, tdbb->getDefaultPool(),
+					DPM_next_pointer_page, &lastRecNo))
+			{
+				count++;
+				JRD_reschedule(tdbb);
+			}
+
+			m_count += count;
+
+			delete rpb.rpb_record;
+			--relation->rel_scan_count;
+
+			return !m_stop;
+		}
+		catch (const Exception& ex)
+		{
+			ex.stuffException(tdbb->tdbb_status_vector);
+
+			delete rpb.rpb_record;
+			if (relation && relation->rel_scan_count)
+				--relation->rel_scan_count;
+		}
+
+		setError(tdbb->tdbb_status_vector);
+		return false;
+	}
+
+	bool ScanCountTask::getWorkItem(WorkItem** pItem)
+	{
+		MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+		Item* item = static_cast<Item*>(*pItem);
+
+		if (!item)
+		{
+			for (Item** p = m_items.begin(); p < m_items.end(); p++)
+			{
+				if (!(*p)->m_inuse)
+				{
+					(*p)->m_inuse = true;
+					*pItem = item = *p;
+					break;
+				}
+			}
+
+			if (!item)
+				return false;
+		}
+
+		if (m_stop || m_nextPP >= m_countPP)
+		{
+			item->m_inuse = false;
+			return false;
+		}
+
+		item->m_pp = m_nextPP++;
+		return true;
+	}
+
+	bool ScanCountTask::getResult(IStatus* status)
+	{
+		if (status)
+		{
+			status->init();
+			status->setErrors(m_status.getErrors());
+		}
+
+		return m_status.isSuccess();
+	}
+} // namespace
+
 // -------------------------------------------
 // Data access: sequential complete table scan
 // -------------------------------------------
@@ -158,6 +442,72 @@ bool FullTableScan::internalGetRecord(thread_db* tdbb) const
 	return false;
 }
 
+// Count records visible to the request using parallel workers. Only a plain
+// scan is counted this way, filtered streams and other aggregates are still
+// evaluated by the requesting attachment.
+bool FullTableScan::countRecords(thread_db* tdbb, SINT64& count) const
+{
+	Database* const dbb = tdbb->getDatabase();
+	Attachment* const attachment = tdbb->getAttachment();
+	Request* const request = tdbb->getRequest();
+	jrd_tra* const transaction = request->req_transaction;
+
+	if (attachment->att_parallel_workers <= 1 || attachment->isWorker() || m_dbkeyRanges.hasData())
+		return false;
+
+	// Classic in single-user shutdown mode can't create additional worker attachments
+	if (dbb->isShutdown(shut_mode_single) && !(dbb->dbb_flags & DBB_shared))
+		return false;
+
+	if (m_relation->isTemporary() || m_relation->isVirtual() || m_relation->rel_file)
+		return false;
+
+	// Worker transactions share the snapshot of the current transaction,
+	// but they cannot see its own changes. So this transaction must be
+	// read-only and either be a snapshot one or use a statement snapshot.
+
+	if ((transaction->tra_flags & TRA_system) || !(transaction->tra_flags & TRA_readonly))
+		return false;
+
+	CommitNumber snapshot = 0;
+
+	if (!(transaction->tra_flags & TRA_read_committed))
+		snapshot = transaction->tra_snapshot_number;
+	else if (transaction->tra_flags & TRA_read_consistency)
+	{
+		const Request* const snapshotRequest = request->req_snapshot.m_owner;
+
+		if (snapshotRequest && !(snapshotRequest->req_flags & req_update_conflict))
+			snapshot = snapshotRequest->req_snapshot.m_number;
+	}
+
+	if (!snapshot)
+		return false;
+
+	const auto pages = m_relation->getPages(tdbb);
+	const ULONG countPP = pages->rel_pages ? pages->rel_pages->count() : 0;
+
+	if (countPP < 2)
+		return false;
+
+	Coordinator coord(dbb->dbb_permanent);
+	ScanCountTask task(tdbb, dbb->dbb_permanent, m_relation, countPP, snapshot,
+		attachment->att_parallel_workers);
+
+	{
+		EngineCheckout cout(tdbb, FB_FUNCTION);
+		coord.runSync(&task);
+	}
+
+	FbLocalStatus localStatus;
+
+	if (!task.getResult(&localStatus))
+		localStatus.raise();
+
+	count = task.getCount();
+	return true;
+}
+
 void FullTableScan::getLegacyPlan(thread_db* tdbb, string& plan, unsigned level) const
 {
 	if (!level)
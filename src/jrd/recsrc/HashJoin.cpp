@@ -43,16 +43,41 @@ using namespace Jrd;
 // Data access: hash join
 // ----------------------
 
-// NS: FIXME - Why use static hash table here??? Hash table shall support dynamic resizing
-static const ULONG HASH_SIZE = 1009;
+// Hash table sizes (primes, roughly doubling each time).
+// The table starts small and grows together with the hashed stream.
+static const ULONG HASH_SIZES[] =
+{
+	1009, 2017, 4027, 8053, 16103, 32203, 64403, 128767, 257519, 514967, 1029929
+};
+
+static const ULONG HASH_SIZE_COUNT = FB_NELEM(HASH_SIZES);
 static const ULONG BUCKET_PREALLOCATE_SIZE = 32;	// 256 bytes per bucket
 
-unsigned HashJoin::maxCapacity()
+// Average number of collisions per bucket that triggers the table growth
+static const ULONG MAX_AVERAGE_COLLISIONS = BUCKET_PREALLOCATE_SIZE / 2;
+
+// Estimated memory used by the hash table per hashed row: the collision
+// entry with the array growth reserve plus the share of bucket overhead
+static const ULONG HASH_ROW_MEMORY = 32;
+
+// Hash table memory is charged against TempCacheLimit in portions of this size
+static const ULONG HASH_CHARGE_SIZE = 64 * 1024;
+
+unsigned HashJoin::maxCapacity(thread_db* tdbb)
 {
 	// Binary search across 1000 collisions is computationally similar to
 	// linear search across 10 collisions. We use this number as a rough
 	// estimation of whether the lookup performance is likely to be acceptable.
-	return HASH_SIZE * 1000;
+	// The hash table grows dynamically, so consider its maximum possible size.
+	const FB_UINT64 maxRows = (FB_UINT64) HASH_SIZES[HASH_SIZE_COUNT - 1] * 1000;
+
+	// Hashed rows are kept by the buffered streams which spill to disk, but
+	// the hash table itself is memory only. Limit it by the memory allowed
+	// for temporary data, still allowing the size of the smallest table.
+	const FB_UINT64 minRows = (FB_UINT64) HASH_SIZES[0] * 1000;
+	const FB_UINT64 budgetRows = tdbb->getDatabase()->dbb_config->getTempCacheLimit() / HASH_ROW_MEMORY;
+
+	return (unsigned) MIN(maxRows, MAX(minRows, budgetRows));
 }
 
 
@@ -99,6 +124,13 @@ class HashJoin::HashTable : public PermanentStorage
 			return (ULONG) m_collisions.getCount();
 		}
 
+		void get(FB_SIZE_T index, ULONG& hash, ULONG& position) const
+		{
+			const Entry& collision = m_collisions[index];
+			hash = collision.hash;
+			position = collision.position;
+		}
+
 		void add(ULONG hash, ULONG position)
 		{
 			m_collisions.add(Entry(hash, position));
@@ -135,57 +167,89 @@ class HashJoin::HashTable : public PermanentStorage
 		FB_SIZE_T m_iterator;
 	};
 
+	// Per-stream hash table, every stream is sized independently
+
+	struct StreamTable
+	{
+		StreamTable()
+			: sizeIndex(0), count(0), collisions(nullptr), current(nullptr)
+		{}
+
+		ULONG getSize() const
+		{
+			return HASH_SIZES[sizeIndex];
+		}
+
+		CollisionList*& getBucket(ULONG hash)
+		{
+			return collisions[hash % getSize()];
+		}
+
+		ULONG sizeIndex;
+		FB_UINT64 count;
+		CollisionList** collisions;
+		CollisionList* current;
+	};
+
 public:
-	HashTable(MemoryPool& pool, ULONG streamCount, ULONG tableSize = HASH_SIZE)
-		: PermanentStorage(pool), m_streamCount(streamCount),
-		  m_tableSize(tableSize), m_slot(0)
+	HashTable(MemoryPool& pool, Database* dbb, ULONG streamCount)
+		: PermanentStorage(pool), m_dbb(dbb), m_streamCount(streamCount),
+		  m_charged(0), m_uncharged(0)
 	{
-		m_collisions = FB_NEW_POOL(pool) CollisionList*[streamCount * tableSize];
-		memset(m_collisions, 0, streamCount * tableSize * sizeof(CollisionList*));
+		m_tables = FB_NEW_POOL(pool) StreamTable[streamCount];
+
+		for (ULONG i = 0; i < m_streamCount; i++)
+			m_tables[i].collisions = allocateBuckets(m_tables[i].getSize());
 	}
 
 	~HashTable()
 	{
-		for (ULONG i = 0; i < m_streamCount * m_tableSize; i++)
-			delete m_collisions[i];
+		for (ULONG i = 0; i < m_streamCount; i++)
+			releaseBuckets(m_tables[i].collisions, m_tables[i].getSize());
 
-		delete[] m_collisions;
+		delete[] m_tables;
+
+		if (m_charged)
+			m_dbb->decTempCacheUsage(m_charged);
 	}
 
 	void put(ULONG stream, ULONG hash, ULONG position)
 	{
-		const ULONG slot = hash % m_tableSize;
-
 		fb_assert(stream < m_streamCount);
-		fb_assert(slot < m_tableSize);
 
-		CollisionList* collisions = m_collisions[stream * m_tableSize + slot];
+		StreamTable& table = m_tables[stream];
 
-		if (!collisions)
+		if (++table.count > (FB_UINT64) table.getSize() * MAX_AVERAGE_COLLISIONS &&
+			table.sizeIndex < HASH_SIZE_COUNT - 1)
 		{
-			collisions = FB_NEW_POOL(getPool()) CollisionList(getPool());
-			m_collisions[stream * m_tableSize + slot] = collisions;
+			grow(table);
 		}
 
+		CollisionList*& collisions = table.getBucket(hash);
+
+		if (!collisions)
+			collisions = FB_NEW_POOL(getPool()) CollisionList(getPool());
+
 		collisions->add(hash, position);
+		charge(HASH_ROW_MEMORY);
 	}
 
 	bool setup(ULONG hash)
 	{
-		const ULONG slot = hash % m_tableSize;
-
 		for (ULONG i = 0; i < m_streamCount; i++)
 		{
-			CollisionList* const collisions = m_collisions[i * m_tableSize + slot];
+			StreamTable& table = m_tables[i];
+			CollisionList* const collisions = table.getBucket(hash);
 
 			if (!collisions)
 				return false;
 
 			if (!collisions->locate(hash))
 				return false;
+
+			table.current = collisions;
 		}
 
-		m_slot = slot;
 		return true;
 	}
 
@@ -193,7 +257,8 @@ public:
 	{
 		fb_assert(stream < m_streamCount);
 
-		CollisionList* const collisions = m_collisions[stream * m_tableSize + m_slot];
+		CollisionList* const collisions = m_tables[stream].current;
+		fb_assert(collisions);
 		collisions->locate(hash);
 	}
 
@@ -201,51 +266,130 @@ public:
 	{
 		fb_assert(stream < m_streamCount);
 
-		CollisionList* const collisions = m_collisions[stream * m_tableSize + m_slot];
+		CollisionList* const collisions = m_tables[stream].current;
+		fb_assert(collisions);
 		return collisions->iterate(hash, position);
 	}
 
 	void sort()
 	{
-		for (ULONG i = 0; i < m_streamCount * m_tableSize; i++)
+		for (ULONG i = 0; i < m_streamCount; i++)
 		{
-			if (const auto collisions = m_collisions[i])
-				collisions->sort();
+			const StreamTable& table = m_tables[i];
+
+			for (ULONG j = 0; j < table.getSize(); j++)
+			{
+				if (const auto collisions = table.collisions[j])
+					collisions->sort();
+			}
 		}
 
 #ifdef PRINT_HASH_TABLE
-		FB_UINT64 total = 0;
-		ULONG min = MAX_ULONG, max = 0, count = 0;
-
-		for (ULONG i = 0; i < m_streamCount * m_tableSize; i++)
+		for (ULONG i = 0; i < m_streamCount; i++)
 		{
-			CollisionList* const collisions = m_collisions[i];
-			if (!collisions)
-				continue;
+			const StreamTable& table = m_tables[i];
 
-			const auto cnt = collisions->getCount();
+			FB_UINT64 total = 0;
+			ULONG min = MAX_ULONG, max = 0, count = 0;
 
-			if (cnt < min)
-				min = cnt;
-			if (cnt > max)
-				max = cnt;
-			total += cnt;
-			count++;
-		}
+			for (ULONG j = 0; j < table.getSize(); j++)
+			{
+				CollisionList* const collisions = table.collisions[j];
+				if (!collisions)
+					continue;
 
-		if (count)
-		{
-			printf("Hash table size %u, count %u, buckets %u, min %u, max %u, avg %u\n",
-				   m_tableSize, (ULONG) total, count, min, max, (ULONG) (total / count));
+				const auto cnt = collisions->getCount();
+
+				if (cnt < min)
+					min = cnt;
+				if (cnt > max)
+					max = cnt;
+				total += cnt;
+				count++;
+			}
+
+			if (count)
+			{
+				printf("Stream %u: hash table size %u, count %u, buckets %u, min %u, max %u, avg %u\n",
+					   i, table.getSize(), (ULONG) total, count, min, max, (ULONG) (total / count));
+			}
 		}
 #endif
 	}
 
 private:
+	CollisionList** allocateBuckets(ULONG size)
+	{
+		CollisionList** const buckets = FB_NEW_POOL(getPool()) CollisionList*[size];
+		memset(buckets, 0, size * sizeof(CollisionList*));
+		charge(size * sizeof(CollisionList*));
+		return buckets;
+	}
+
+	// The hash table is memory only, it can't be spilled to disk. Yet it's
+	// accounted as temporary data, so other temporary spaces (sorts and the
+	// buffered streams) go to disk earlier rather than exceed the limit.
+	// Memory beyond the limit is used anyway, it's just not charged.
+
+	void charge(FB_SIZE_T size)
+	{
+		m_uncharged += size;
+
+		if (m_uncharged >= HASH_CHARGE_SIZE)
+		{
+			if (m_charged <= MAX_ULONG - m_uncharged && m_dbb->incTempCacheUsage(m_uncharged))
+				m_charged += m_uncharged;
+
+			m_uncharged = 0;
+		}
+	}
+
+	void releaseBuckets(CollisionList** buckets, ULONG size)
+	{
+		for (ULONG i = 0; i < size; i++)
+			delete buckets[i];
+
+		delete[] buckets;
+	}
+
+	void grow(StreamTable& table)
+	{
+		// Switch to the next table size and redistribute the already hashed entries
+
+		const ULONG oldSize = table.getSize();
+		CollisionList** const oldBuckets = table.collisions;
+
+		table.sizeIndex++;
+		table.collisions = allocateBuckets(table.getSize());
+
+		for (ULONG i = 0; i < oldSize; i++)
+		{
+			CollisionList* const oldCollisions = oldBuckets[i];
+			if (!oldCollisions)
+				continue;
+
+			for (FB_SIZE_T j = 0; j < oldCollisions->getCount(); j++)
+			{
+				ULONG hash, position;
+				oldCollisions->get(j, hash, position);
+
+				CollisionList*& collisions = table.getBucket(hash);
+
+				if (!collisions)
+					collisions = FB_NEW_POOL(getPool()) CollisionList(getPool());
+
+				collisions->add(hash, position);
+			}
+		}
+
+		releaseBuckets(oldBuckets, oldSize);
+	}
+
+	Database* const m_dbb;
 	const ULONG m_streamCount;
-	const ULONG m_tableSize;
-	CollisionList** m_collisions;
-	ULONG m_slot;
+	StreamTable* m_tables;
+	FB_SIZE_T m_charged;		// charged against TempCacheLimit
+	FB_SIZE_T m_uncharged;		// allocated since the last charge
 };
 
 
@@ -254,7 +398,9 @@ HashJoin::HashJoin(thread_db* tdbb, CompilerScratch* csb, JoinType joinType,
 				   double selectivity)
 	: RecordSource(csb),
 	  m_joinType(joinType),
+	  m_fullJoin(false),
 	  m_boolean(nullptr),
+	  m_matchBoolean(nullptr),
 	  m_args(csb->csb_pool, count - 1)
 {
 	fb_assert(count >= 2);
@@ -263,12 +409,14 @@ HashJoin::HashJoin(thread_db* tdbb, CompilerScratch* csb, JoinType joinType,
 }
 
 HashJoin::HashJoin(thread_db* tdbb, CompilerScratch* csb,
-				   BoolExprNode* boolean,
+				   BoolExprNode* boolean, BoolExprNode* matchBoolean,
 				   RecordSource* const* args, NestValueArray* const* keys,
-				   double selectivity)
+				   bool fullJoin, double selectivity)
 	: RecordSource(csb),
 	  m_joinType(OUTER_JOIN),
+	  m_fullJoin(fullJoin),
 	  m_boolean(boolean),
+	  m_matchBoolean(matchBoolean),
 	  m_args(csb->csb_pool, 1)
 {
 	init(tdbb, csb, 2, args, keys, selectivity);
@@ -376,6 +524,10 @@ void HashJoin::internalOpen(thread_db* tdbb) const
 	delete[] impure->irsb_leader_buffer;
 	impure->irsb_leader_buffer = nullptr;
 
+	delete[] impure->irsb_inner_matches;
+	impure->irsb_inner_matches = nullptr;
+	impure->irsb_inner_count = impure->irsb_inner_position = 0;
+
 	m_leader.source->open(tdbb);
 }
 
@@ -396,6 +548,9 @@ void HashJoin::close(thread_db* tdbb) const
 		delete[] impure->irsb_leader_buffer;
 		impure->irsb_leader_buffer = nullptr;
 
+		delete[] impure->irsb_inner_matches;
+		impure->irsb_inner_matches = nullptr;
+
 		for (FB_SIZE_T i = 0; i < m_args.getCount(); i++)
 			m_args[i].buffer->close(tdbb);
 
@@ -413,6 +568,10 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 	if (!(impure->irsb_flags & irsb_open))
 		return false;
 
+	// The leading stream is exhausted, return the unmatched inner records (if requested)
+	if (impure->irsb_flags & irsb_joined)
+		return fetchUnmatchedRecord(tdbb, impure);
+
 	const auto inner = m_args.front().source;
 
 	while (true)
@@ -422,7 +581,13 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 			// Fetch the record from the leading stream
 
 			if (!m_leader.source->getRecord(tdbb))
-				return false;
+			{
+				if (!m_fullJoin)
+					return false;
+
+				impure->irsb_flags |= irsb_joined;
+				return fetchUnmatchedRecord(tdbb, impure);
+			}
 
 			if (m_boolean && !m_boolean->execute(tdbb, request))
 			{
@@ -434,35 +599,8 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 
 			// We have something to join with, so ensure the hash table is initialized
 
-			if (!impure->irsb_hash_table && !impure->irsb_leader_buffer)
-			{
-				auto& pool = *tdbb->getDefaultPool();
-				const auto argCount = m_args.getCount();
-
-				impure->irsb_hash_table = FB_NEW_POOL(pool) HashTable(pool, argCount);
-				impure->irsb_leader_buffer = FB_NEW_POOL(pool) UCHAR[m_leader.totalKeyLength];
-
-				UCharBuffer buffer(pool);
-
-				for (FB_SIZE_T i = 0; i < argCount; i++)
-				{
-					// Read and cache the inner streams. While doing that,
-					// hash the join condition values and populate hash tables.
-
-					m_args[i].buffer->open(tdbb);
-
-					ULONG counter = 0;
-					const auto keyBuffer = buffer.getBuffer(m_args[i].totalKeyLength, false);
-
-					while (m_args[i].buffer->getRecord(tdbb))
-					{
-						const auto hash = computeHash(tdbb, request, m_args[i], keyBuffer);
-						impure->irsb_hash_table->put(i, hash, counter++);
-					}
-				}
-
-				impure->irsb_hash_table->sort();
-			}
+			if (!impure->irsb_hash_table)
+				buildHashTable(tdbb, impure);
 
 			// Compute and hash the comparison keys
 
@@ -527,7 +665,7 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 		}
 		else if (!fetchRecord(tdbb, impure, m_args.getCount() - 1))
 		{
-			fb_assert(m_joinType == INNER_JOIN);
+			fb_assert(m_joinType == INNER_JOIN || m_joinType == OUTER_JOIN);
 			impure->irsb_flags |= irsb_mustread;
 			continue;
 		}
@@ -538,6 +676,52 @@ bool HashJoin::internalGetRecord(thread_db* tdbb) const
 	return true;
 }
 
+void HashJoin::buildHashTable(thread_db* tdbb, Impure* impure) const
+{
+	Request* const request = tdbb->getRequest();
+
+	auto& pool = *tdbb->getDefaultPool();
+	const auto argCount = m_args.getCount();
+
+	impure->irsb_hash_table = FB_NEW_POOL(pool) HashTable(pool, tdbb->getDatabase(), argCount);
+	impure->irsb_leader_buffer = FB_NEW_POOL(pool) UCHAR[m_leader.totalKeyLength];
+
+	UCharBuffer buffer(pool);
+
+	for (FB_SIZE_T i = 0; i < argCount; i++)
+	{
+		// Read and cache the inner streams. While doing that,
+		// hash the join condition values and populate hash tables.
+
+		m_args[i].buffer->open(tdbb);
+
+		ULONG counter = 0;
+		const auto keyBuffer = buffer.getBuffer(m_args[i].totalKeyLength, false);
+
+		while (m_args[i].buffer->getRecord(tdbb))
+		{
+			const auto hash = computeHash(tdbb, request, m_args[i], keyBuffer);
+			impure->irsb_hash_table->put(i, hash, counter++);
+		}
+
+		if (m_fullJoin)
+		{
+			// Track the inner records being matched, the remaining ones
+			// are to be returned after the leading stream is exhausted
+
+			fb_assert(argCount == 1);
+
+			const ULONG length = FLAG_BYTES(counter);
+			impure->irsb_inner_matches = FB_NEW_POOL(pool) UCHAR[length];
+			memset(impure->irsb_inner_matches, 0, length);
+			impure->irsb_inner_count = counter;
+			impure->irsb_inner_position = 0;
+		}
+	}
+
+	impure->irsb_hash_table->sort();
+}
+
 bool HashJoin::refetchRecord(thread_db* /*tdbb*/) const
 {
 	return true;
@@ -577,7 +761,7 @@ void HashJoin::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned l
 			break;
 
 		case OUTER_JOIN:
-			planEntry.lines.back().text += "(outer)";
+			planEntry.lines.back().text += m_fullJoin ? "(full outer)" : "(outer)";
 			break;
 
 		case SEMI_JOIN:
@@ -638,7 +822,8 @@ bool HashJoin::isDependent(const StreamList& streams) const
 			return true;
 	}
 
-	return (m_boolean && m_boolean->containsAnyStream(streams));
+	return (m_boolean && m_boolean->containsAnyStream(streams)) ||
+		(m_matchBoolean && m_matchBoolean->containsAnyStream(streams));
 }
 
 void HashJoin::invalidateRecords(Request* request) const
@@ -740,14 +925,10 @@ bool HashJoin::fetchRecord(thread_db* tdbb, Impure* impure, FB_SIZE_T stream) co
 {
 	HashTable* const hashTable = impure->irsb_hash_table;
 
-	const BufferedStream* const arg = m_args[stream].buffer;
-
 	ULONG position;
-	if (hashTable->iterate(stream, impure->irsb_leader_hash, position))
+	while (hashTable->iterate(stream, impure->irsb_leader_hash, position))
 	{
-		arg->locate(tdbb, position);
-
-		if (arg->getRecord(tdbb))
+		if (fetchMatchedRecord(tdbb, impure, stream, position))
 			return true;
 	}
 
@@ -761,12 +942,63 @@ bool HashJoin::fetchRecord(thread_db* tdbb, Impure* impure, FB_SIZE_T stream) co
 
 		hashTable->reset(stream, impure->irsb_leader_hash);
 
-		if (hashTable->iterate(stream, impure->irsb_leader_hash, position))
+		while (hashTable->iterate(stream, impure->irsb_leader_hash, position))
 		{
-			arg->locate(tdbb, position);
-
-			if (arg->getRecord(tdbb))
+			if (fetchMatchedRecord(tdbb, impure, stream, position))
 				return true;
 		}
 	}
 }
+
+bool HashJoin::fetchMatchedRecord(thread_db* tdbb, Impure* impure,
+								  FB_SIZE_T stream, ULONG position) const
+{
+	const BufferedStream* const arg = m_args[stream].buffer;
+
+	arg->locate(tdbb, position);
+
+	if (!arg->getRecord(tdbb))
+		return false;
+
+	// Hash values may collide and the join condition may include more than
+	// just the hashed keys, so re-check the whole condition if it's provided
+
+	if (m_matchBoolean && !m_matchBoolean->execute(tdbb, tdbb->getRequest()))
+		return false;
+
+	if (impure->irsb_inner_matches)
+		impure->irsb_inner_matches[position >> 3] |= (1 << (position & 7));
+
+	return true;
+}
+
+bool HashJoin::fetchUnmatchedRecord(thread_db* tdbb, Impure* impure) const
+{
+	fb_assert(m_fullJoin);
+
+	// The leading stream might be empty (or filtered out completely by the boolean),
+	// so the inner stream may be not cached yet
+
+	if (!impure->irsb_hash_table)
+		buildHashTable(tdbb, impure);
+
+	const BufferedStream* const arg = m_args.front().buffer;
+
+	while (impure->irsb_inner_position < impure->irsb_inner_count)
+	{
+		const ULONG position = impure->irsb_inner_position++;
+
+		if (impure->irsb_inner_matches[position >> 3] & (1 << (position & 7)))
+			continue;
+
+		arg->locate(tdbb, position);
+
+		if (arg->getRecord(tdbb))
+		{
+			m_leader.source->nullRecords(tdbb);
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -25,6 +25,7 @@
 #include "../jrd/btr_proto.h"
 #include "../jrd/cch_proto.h"
 #include "../jrd/cmp_proto.h"
+#include "../jrd/dpm_proto.h"
 #include "../jrd/evl_proto.h"
 #include "../jrd/met_proto.h"
 #include "../jrd/vio_proto.h"
@@ -78,6 +79,14 @@ void IndexTableScan::internalOpen(thread_db* tdbb) const
 
 	fb_assert(!impure->irsb_nav_upper);
 	impure->irsb_nav_current_upper = impure->irsb_nav_upper = FB_NEW_POOL(*tdbb->getDefaultPool()) temporary_key;
+
+	if (m_indexOnly)
+	{
+		fb_assert(!impure->irsb_nav_visible);
+		impure->irsb_nav_visible =
+			FB_NEW_POOL(*tdbb->getDefaultPool()) UCHAR[(tdbb->getDatabase()->dbb_dp_per_pp + 7) / 8];
+		impure->irsb_nav_visible_page = 0;
+	}
 }
 
 void IndexTableScan::close(thread_db* tdbb) const
@@ -136,6 +145,12 @@ void IndexTableScan::close(thread_db* tdbb) const
 			delete impure->irsb_iterator;
 			impure->irsb_iterator = NULL;
 		}
+
+		if (impure->irsb_nav_visible)
+		{
+			delete[] impure->irsb_nav_visible;
+			impure->irsb_nav_visible = NULL;
+		}
 	}
 #ifdef DEBUG_LCK_LIST
 	// paranoid check
@@ -332,6 +347,28 @@ bool IndexTableScan::internalGetRecord(thread_db* tdbb) const
 
 			CCH_RELEASE(tdbb, &window);
 
+			// If the data page contains only primary record versions visible to everybody,
+			// the key is known to match the record, so restore it without fetching the page
+
+			if (m_indexOnly &&
+				!(rpb->rpb_stream_flags & (RPB_s_update | RPB_s_unstable | RPB_s_keyed)) &&
+				isAllVisible(tdbb, impure, number))
+			{
+				const auto format = MET_current(tdbb, m_relation);
+				const auto record = VIO_record(tdbb, rpb, format, request->req_pool);
+				rpb->rpb_format_number = format->fmt_version;
+
+				BTR_decode_key(tdbb, idx, &key, record);
+
+				tdbb->bumpRelStats(RuntimeStatistics::RECORD_IDX_READS, m_relation->rel_id);
+
+				RBM_SET(tdbb->getDefaultPool(), &impure->irsb_nav_records_visited,
+						rpb->rpb_number.getValue());
+
+				rpb->rpb_number.setValid(true);
+				return true;
+			}
+
 			if (VIO_get(tdbb, rpb, request->req_transaction, request->req_pool))
 			{
 				if (const auto result = recordKey.compose(rpb->rpb_record))
@@ -395,7 +432,8 @@ void IndexTableScan::internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsi
 {
 	planEntry.className = "IndexTableScan";
 
-	planEntry.lines.add().text = "Table " + printName(tdbb, m_relation->rel_name.c_str(), m_alias) + " Access By ID";
+	planEntry.lines.add().text = "Table " + printName(tdbb, m_relation->rel_name.c_str(), m_alias) +
+		(m_indexOnly ? " Index Only Access" : " Access By ID");
 	printOptInfo(planEntry.lines);
 
 	printInversion(tdbb, m_index, planEntry.lines, true, 1, true);
@@ -749,6 +787,36 @@ void IndexTableScan::setPosition(thread_db* tdbb,
 	impure->irsb_nav_offset = pointer - (UCHAR*) window->win_buffer;
 }
 
+bool IndexTableScan::isAllVisible(thread_db* tdbb, Impure* impure, RecordNumber number) const
+{
+	// Check whether the data page of the record is marked all-visible. The bits of
+	// the pointer page are cached. They are valid for keys read from the same index
+	// page incarnation, as the bit is cleared before the index key of a new record
+	// version is inserted.
+
+	const Database* const dbb = tdbb->getDatabase();
+
+	if (number.getValue() < 0)
+		return false;
+
+	ULONG sequence;
+	USHORT slot, line;
+	number.decompose(dbb->dbb_max_records, dbb->dbb_dp_per_pp, line, slot, sequence);
+
+	if (impure->irsb_nav_visible_page != impure->irsb_nav_page ||
+		impure->irsb_nav_visible_incarnation != impure->irsb_nav_incarnation ||
+		impure->irsb_nav_visible_sequence != sequence)
+	{
+		DPM_all_visible(tdbb, m_relation, sequence, impure->irsb_nav_visible);
+
+		impure->irsb_nav_visible_page = impure->irsb_nav_page;
+		impure->irsb_nav_visible_incarnation = impure->irsb_nav_incarnation;
+		impure->irsb_nav_visible_sequence = sequence;
+	}
+
+	return (impure->irsb_nav_visible[slot / 8] & (1 << (slot % 8))) != 0;
+}
+
 bool IndexTableScan::setupBitmaps(thread_db* tdbb, Impure* impure) const
 {
 	// Start a bitmap which tells us we have already visited
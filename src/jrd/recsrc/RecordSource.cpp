@@ -214,6 +214,8 @@ void RecordSource::printInversion(thread_db* tdbb, const InversionNode* inversio
 
 				const bool fullscan = (maxSegs == 0);
 				const bool list = (retrieval->irb_list != nullptr);
+				const bool skip = (retrieval->irb_generic & irb_skip_scan);
+				const bool blockRange = (idx.idx_flags & idx_block_range);
 
 				string bounds;
 				if (!unique && !fullscan)
@@ -247,7 +249,8 @@ void RecordSource::printInversion(thread_db* tdbb, const InversionNode* inversio
 				}
 
 				plan->text = "Index " + printName(tdbb, indexName.c_str()) +
-					(fullscan ? " Full" : unique ? " Unique" : list ? " List" : " Range") + " Scan" + bounds;
+					(blockRange ? " Block" : "") +
+					(fullscan ? " Full" : unique ? " Unique" : skip ? " Skip" : list ? " List" : " Range") + " Scan" + bounds;
 			}
 			else
 				plan->text = printName(tdbb, indexName.c_str(), false);
@@ -43,6 +43,7 @@ namespace Jrd
 	class BoolExprNode;
 	class DeclareLocalTableNode;
 	class Sort;
+	class PartitionedSort;
 	class CompilerScratch;
 	class BtrPageGCLock;
 	struct index_desc;
@@ -155,6 +156,13 @@ namespace Jrd
 			fb_assert(false);
 		}
 
+		// Count the records of an open stream at once, without fetching them.
+		// Returns false if the stream cannot do that.
+		virtual bool countRecords(thread_db* /*tdbb*/, SINT64& /*count*/) const
+		{
+			return false;
+		}
+
 		static bool rejectDuplicate(const UCHAR* /*data1*/, const UCHAR* /*data2*/, void* /*userArg*/)
 		{
 			return true;
@@ -246,6 +254,8 @@ namespace Jrd
 
 		void close(thread_db* tdbb) const override;
 
+		bool countRecords(thread_db* tdbb, SINT64& count) const override;
+
 		void getLegacyPlan(thread_db* tdbb, Firebird::string& plan, unsigned level) const override;
 
 	protected:
@@ -264,6 +274,7 @@ namespace Jrd
 		struct Impure : public RecordSource::Impure
 		{
 			RecordBitmap** irsb_bitmap;
+			SINT64 irsb_read_ahead;						// record number to request the next read-ahead at
 		};
 
 	public:
@@ -301,6 +312,10 @@ namespace Jrd
 			temporary_key* irsb_nav_current_lower;		// current lower key
 			temporary_key* irsb_nav_current_upper;		// current upper key
 			IndexScanListIterator* irsb_iterator;		// key list iterator
+			UCHAR* irsb_nav_visible;					// all-visible data pages of pointer page
+			ULONG irsb_nav_visible_sequence;			// pointer page of irsb_nav_visible
+			ULONG irsb_nav_visible_page;				// index page irsb_nav_visible is valid for
+			SLONG irsb_nav_visible_incarnation;			// and its incarnation
 			USHORT irsb_nav_offset;						// page offset of current index node
 			USHORT irsb_nav_upper_length;				// length of upper key value
 			USHORT irsb_nav_length;						// length of expanded key
@@ -324,6 +339,17 @@ namespace Jrd
 			m_condition = condition;
 		}
 
+		const InversionNode* getIndex() const
+		{
+			return m_index;
+		}
+
+		// Restore records from the index keys where possible
+		void setIndexOnly()
+		{
+			m_indexOnly = true;
+		}
+
 	protected:
 		void internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned level, bool recurse) const override;
 		void internalOpen(thread_db* tdbb) const override;
@@ -340,6 +366,7 @@ namespace Jrd
 		void setPosition(thread_db* tdbb, Impure* impure, record_param*,
 						 win* window, const UCHAR*, const temporary_key&) const;
 		bool setupBitmaps(thread_db* tdbb, Impure* impure) const;
+		bool isAllVisible(thread_db* tdbb, Impure* impure, RecordNumber number) const;
 
 		const Firebird::string m_alias;
 		jrd_rel* const m_relation;
@@ -348,6 +375,7 @@ namespace Jrd
 		NestConst<BoolExprNode> m_condition;
 		const FB_SIZE_T m_length;
 		FB_SIZE_T m_offset;
+		bool m_indexOnly = false;
 	};
 
 	class ExternalTableScan final : public RecordStream
@@ -646,6 +674,7 @@ namespace Jrd
 		struct Impure : public RecordSource::Impure
 		{
 			Sort* irsb_sort;
+			PartitionedSort* irsb_partitions;
 		};
 
 	public:
@@ -761,7 +790,9 @@ namespace Jrd
 		bool internalGetRecord(thread_db* tdbb) const override;
 
 	private:
-		Sort* init(thread_db* tdbb) const;
+		void init(thread_db* tdbb, Impure* impure) const;
+		void initParallel(thread_db* tdbb, Impure* impure, int workers, Sort* first) const;
+		void buildRecord(thread_db* tdbb, Request* request, UCHAR* data) const;
 
 		NestConst<RecordSource> m_next;
 		const SortMap* const m_map;
@@ -949,6 +980,11 @@ namespace Jrd
 	protected:
 		void internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned level, bool recurse) const override;
 		bool internalGetRecord(thread_db* tdbb) const override;
+
+	private:
+		bool evaluateCount(thread_db* tdbb) const;
+
+		bool m_countOnly;
 	};
 
 	class WindowedStream : public RecordSource
@@ -1244,6 +1280,9 @@ namespace Jrd
 			HashTable* irsb_hash_table;
 			UCHAR* irsb_leader_buffer;
 			ULONG irsb_leader_hash;
+			UCHAR* irsb_inner_matches;		// bitmap of matched inner records (full join only)
+			ULONG irsb_inner_count;
+			ULONG irsb_inner_position;
 		};
 
 	public:
@@ -1251,9 +1290,9 @@ namespace Jrd
 				 FB_SIZE_T count, RecordSource* const* args, NestValueArray* const* keys,
 				 double selectivity = 0);
 		HashJoin(thread_db* tdbb, CompilerScratch* csb,
-				 BoolExprNode* boolean,
+				 BoolExprNode* boolean, BoolExprNode* matchBoolean,
 				 RecordSource* const* args, NestValueArray* const* keys,
-				 double selectivity = 0);
+				 bool fullJoin = false, double selectivity = 0);
 
 		void close(thread_db* tdbb) const override;
 
@@ -1269,7 +1308,7 @@ namespace Jrd
 		bool isDependent(const StreamList& streams) const override;
 		void nullRecords(thread_db* tdbb) const override;
 
-		static unsigned maxCapacity();
+		static unsigned maxCapacity(thread_db* tdbb);
 
 	protected:
 		void internalGetPlan(thread_db* tdbb, PlanEntry& planEntry, unsigned level, bool recurse) const override;
@@ -1282,10 +1321,16 @@ namespace Jrd
 				  double selectivity);
 		ULONG computeHash(thread_db* tdbb, Request* request,
 						  const SubStream& sub, UCHAR* buffer) const;
+		void buildHashTable(thread_db* tdbb, Impure* impure) const;
 		bool fetchRecord(thread_db* tdbb, Impure* impure, FB_SIZE_T stream) const;
+		bool fetchMatchedRecord(thread_db* tdbb, Impure* impure,
+								FB_SIZE_T stream, ULONG position) const;
+		bool fetchUnmatchedRecord(thread_db* tdbb, Impure* impure) const;
 
 		const JoinType m_joinType;
+		const bool m_fullJoin;
 		const NestConst<BoolExprNode> m_boolean;
+		const NestConst<BoolExprNode> m_matchBoolean;
 
 		SubStream m_leader;
 		Firebird::Array<SubStream> m_args;
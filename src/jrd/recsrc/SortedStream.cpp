@@ -23,6 +23,7 @@
 #include "../jrd/intl.h"
 #include "../jrd/req.h"
 #include "../jrd/tra.h"
+#include "../jrd/sort.h"
 #include "../dsql/ExprNodes.h"
 #include "../jrd/cch_proto.h"
 #include "../jrd/cmp_proto.h"
@@ -33,12 +34,325 @@
 #include "../jrd/mov_proto.h"
 #include "../jrd/vio_proto.h"
 #include "../jrd/optimizer/Optimizer.h"
+#include "../common/Task.h"
 
 #include "RecordSource.h"
 
 using namespace Firebird;
 using namespace Jrd;
 
+namespace
+{
+	// Input records are distributed between sort partitions in batches of this size
+	const ULONG PARTITION_BATCH_SIZE = 1024 * 1024;	// 1MB
+
+	// Number of batch buffers per partition
+	const ULONG PARTITION_BATCH_BUFFERS = 2;
+
+	// Sort goes parallel once the records put into it take this size,
+	// or once it has been written to scratch file
+	const FB_UINT64 PARALLEL_SORT_THRESHOLD = 8 * 1024 * 1024;	// 8MB
+
+	// Task that puts the batches of sort records built by the request
+	// into the partition sorts and sorts them in parallel. Each worker
+	// fills its own partition with whatever batch is ready. The sorted
+	// partitions are merged later by the PartitionedSort while the records
+	// are fetched.
+
+	class SortPartitionTask : public Task
+	{
+	public:
+		class Item : public Task::WorkItem
+		{
+		public:
+			Item(SortPartitionTask* task, Sort* sort)
+				: Task::WorkItem(task),
+				  m_sort(sort)
+			{}
+
+			Sort* const m_sort;
+		};
+
+		SortPartitionTask(Database* dbb, MemoryPool& pool, ULONG recordLength, ULONG batchSize, int workers)
+			: m_dbb(dbb),
+			  m_pool(pool),
+			  m_recordLength(recordLength),
+			  m_batchSize(batchSize),
+			  m_maxBuffers(workers * PARTITION_BATCH_BUFFERS),
+			  m_items(pool),
+			  m_nextItem(0),
+			  m_buffers(pool),
+			  m_full(pool),
+			  m_free(pool),
+			  m_eof(false),
+			  m_stop(false)
+		{}
+
+		~SortPartitionTask()
+		{
+			for (auto item : m_items)
+				delete item;
+
+			for (auto buffer : m_buffers)
+				delete[] buffer;
+		}
+
+		void addPartition(Sort* sort)
+		{
+			m_items.add(FB_NEW_POOL(m_pool) Item(this, sort));
+		}
+
+		UCHAR* getBuffer(thread_db* tdbb);
+		void putBatch(UCHAR* data, ULONG length);
+		void finish();
+		void stop();
+
+		bool handler(WorkItem& _item) override;
+		bool getWorkItem(WorkItem** pItem) override;
+		bool getResult(IStatus* status) override;
+
+		int getMaxWorkers() override
+		{
+			return (int) m_items.getCount();
+		}
+
+		static THREAD_ENTRY_DECLARE run(THREAD_ENTRY_PARAM arg);
+
+	private:
+		struct Batch
+		{
+			UCHAR* data;
+			ULONG length;
+		};
+
+		bool getBatch(Batch& batch);
+		void releaseBuffer(UCHAR* data);
+
+		void setError(IStatus* status)
+		{
+			{	// scope
+				MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+				if (m_status.isSuccess())
+					m_status.save(status);
+			}
+
+			stop();
+		}
+
+		Database* const m_dbb;
+		MemoryPool& m_pool;
+		const ULONG m_recordLength;
+		const ULONG m_batchSize;
+		const ULONG m_maxBuffers;
+		HalfStaticArray<Item*, 8> m_items;
+		FB_SIZE_T m_nextItem;
+
+		HalfStaticArray<UCHAR*, 16> m_buffers;	// batch buffers allocated so far
+		HalfStaticArray<Batch, 16> m_full;		// batches ready to be sorted
+		HalfStaticArray<UCHAR*, 16> m_free;		// buffers ready to be filled
+		Semaphore m_fullSem;
+		Semaphore m_freeSem;
+		bool m_eof;
+
+		Mutex m_mutex;
+		StatusHolder m_status;
+		volatile bool m_stop;
+	};
+
+	// Get a free buffer for the next batch. Buffers are allocated as needed up to
+	// the limit, then wait for one if every buffer is in use.
+	// Returns nullptr if the workers have been stopped.
+
+	UCHAR* SortPartitionTask::getBuffer(thread_db* tdbb)
+	{
+		while (true)
+		{
+			{	// scope
+				MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+				if (m_stop)
+					return nullptr;
+
+				if (m_free.hasData())
+					return m_free.pop();
+
+				if (m_buffers.getCount() < m_maxBuffers)
+				{
+					UCHAR* const buffer = FB_NEW_POOL(m_pool) UCHAR[m_batchSize];
+					m_buffers.add(buffer);
+					return buffer;
+				}
+			}
+
+			EngineCheckout cout(tdbb, FB_FUNCTION);
+			m_freeSem.enter();
+		}
+	}
+
+	void SortPartitionTask::putBatch(UCHAR* data, ULONG length)
+	{
+		{	// scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+			Batch batch;
+			batch.data = data;
+			batch.length = length;
+			m_full.add(batch);
+		}
+
+		m_fullSem.release();
+	}
+
+	// No more batches, let the workers sort what they got
+
+	void SortPartitionTask::finish()
+	{
+		{	// scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+			m_eof = true;
+		}
+
+		m_fullSem.release(m_items.getCount());
+	}
+
+	void SortPartitionTask::stop()
+	{
+		{	// scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+			m_stop = true;
+		}
+
+		m_fullSem.release(m_items.getCount());
+		m_freeSem.release();
+	}
+
+	bool SortPartitionTask::getBatch(Batch& batch)
+	{
+		while (true)
+		{
+			{	// scope
+				MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+				if (m_stop)
+					return false;
+
+				if (m_full.hasData())
+				{
+					batch = m_full[0];
+					m_full.remove((FB_SIZE_T) 0);
+					return true;
+				}
+
+				if (m_eof)
+					return false;
+			}
+
+			m_fullSem.enter();
+		}
+	}
+
+	void SortPartitionTask::releaseBuffer(UCHAR* data)
+	{
+		{	// scope
+			MutexLockGuard guard(m_mutex, FB_FUNCTION);
+			m_free.push(data);
+		}
+
+		m_freeSem.release();
+	}
+
+	bool SortPartitionTask::handler(WorkItem& _item)
+	{
+		Item* const item = static_cast<Item*>(&_item);
+
+		// Sorting doesn't touch the database, so the worker needs no attachment.
+		// The database is required for the temporary space accounting only.
+
+		ThreadContextHolder tdbb(NULL);
+		tdbb->setDatabase(m_dbb);
+
+		try
+		{
+			Sort* const sort = item->m_sort;
+			Batch batch;
+
+			while (getBatch(batch))
+			{
+				for (const UCHAR* data = batch.data; data < batch.data + batch.length; data += m_recordLength)
+				{
+					ULONG* record = nullptr;
+					sort->put(tdbb, &record);
+					memcpy(record, data, m_recordLength);
+				}
+
+				releaseBuffer(batch.data);
+			}
+
+			if (!m_stop)
+				sort->sort(tdbb);
+		}
+		catch (const Exception& ex)
+		{
+			ex.stuffException(tdbb->tdbb_status_vector);
+			setError(tdbb->tdbb_status_vector);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SortPartitionTask::getWorkItem(WorkItem** pItem)
+	{
+		MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+		if (m_stop || m_nextItem >= m_items.getCount())
+			return false;
+
+		*pItem = m_items[m_nextItem++];
+		return true;
+	}
+
+	bool SortPartitionTask::getResult(IStatus* status)
+	{
+		if (status)
+		{
+			status->init();
+			status->setErrors(m_status.getErrors());
+		}
+
+		return m_status.isSuccess();
+	}
+
+	// The workers are coordinated by a separate thread while the request
+	// thread keeps producing the batches
+
+	THREAD_ENTRY_DECLARE SortPartitionTask::run(THREAD_ENTRY_PARAM arg)
+	{
+		SortPartitionTask* const task = static_cast<SortPartitionTask*>(arg);
+
+		try
+		{
+			Coordinator coord(task->m_dbb->dbb_permanent);
+			coord.runSync(task);
+
+			// Handle the partitions no worker was available for
+
+			WorkItem* item;
+			while (task->getWorkItem(&item))
+				task->handler(*item);
+		}
+		catch (const Exception& ex)
+		{
+			FbLocalStatus localStatus;
+			ex.stuffException(&localStatus);
+			task->setError(&localStatus);
+		}
+
+		return 0;
+	}
+} // namespace
+
 // -----------------------------
 // Data access: external sorting
 // -----------------------------
@@ -65,11 +379,14 @@ void SortedStream::internalOpen(thread_db* tdbb) const
 	impure->irsb_flags = irsb_open;
 
 	// Get rid of the old sort areas if this request has been used already.
-	// Null the pointer before calling init() because it may throw.
+	// Null the pointers before calling init() because it may throw.
 	delete impure->irsb_sort;
 	impure->irsb_sort = nullptr;
 
-	impure->irsb_sort = init(tdbb);
+	delete impure->irsb_partitions;
+	impure->irsb_partitions = nullptr;
+
+	init(tdbb, impure);
 }
 
 void SortedStream::close(thread_db* tdbb) const
@@ -87,6 +404,9 @@ void SortedStream::close(thread_db* tdbb) const
 		delete impure->irsb_sort;
 		impure->irsb_sort = nullptr;
 
+		delete impure->irsb_partitions;
+		impure->irsb_partitions = nullptr;
+
 		m_next->close(tdbb);
 	}
 }
@@ -185,9 +505,10 @@ void SortedStream::nullRecords(thread_db* tdbb) const
 	m_next->nullRecords(tdbb);
 }
 
-Sort* SortedStream::init(thread_db* tdbb) const
+void SortedStream::init(thread_db* tdbb, Impure* impure) const
 {
 	Request* const request = tdbb->getRequest();
+	const Attachment* const attachment = tdbb->getAttachment();
 
 	m_next->open(tdbb);
 
@@ -200,12 +521,15 @@ Sort* SortedStream::init(thread_db* tdbb) const
 			 m_map->keyItems.begin(),
 			 ((m_map->flags & FLAG_PROJECT) ? rejectDuplicate : nullptr), 0));
 
+	// Large sorts may be continued in partitions that are sorted by parallel workers
+
+	const bool parallel = (attachment->att_parallel_workers > 1 && !attachment->isWorker());
+	FB_UINT64 size = 0;
+
 	// Pump the input stream dry while pushing records into sort. For
 	// each record, map all fields into the sort record. The reverse
 	// mapping is done in get_sort().
 
-	dsc to, temp;
-
 	while (m_next->getRecord(tdbb))
 	{
 		// "Put" a record to sort. Actually, get the address of a place
@@ -214,79 +538,187 @@ Sort* SortedStream::init(thread_db* tdbb) const
 		UCHAR* data = nullptr;
 		scb->put(tdbb, reinterpret_cast<ULONG**>(&data));
 
-		// Zero out the sort key. This solves a multitude of problems.
+		buildRecord(tdbb, request, data);
 
-		memset(data, 0, m_map->length);
-
-		// Loop thru all field (keys and hangers on) involved in the sort.
-		// Be careful to null field all unused bytes in the sort key.
-
-		const SortMap::Item* const end_item = m_map->items.begin() + m_map->items.getCount();
-		for (const SortMap::Item* item = m_map->items.begin(); item < end_item; item++)
+		if (parallel)
 		{
-			to = item->desc;
-			to.dsc_address = data + (IPTR) to.dsc_address;
-			bool flag = false;
-			dsc* from = nullptr;
+			size += m_map->length;
 
-			if (item->node)
+			if (size >= PARALLEL_SORT_THRESHOLD || scb->hasRuns())
 			{
-				from = EVL_expr(tdbb, request, item->node);
-				if (request->req_flags & req_null)
-					flag = true;
+				initParallel(tdbb, impure, attachment->att_parallel_workers, scb.release());
+				return;
 			}
-			else
-			{
-				from = &temp;
+		}
+	}
 
-				record_param* const rpb = &request->req_rpb[item->stream];
+	scb->sort(tdbb);
 
-				if (item->fieldId < 0)
-				{
-					switch (item->fieldId)
-					{
-					case ID_TRANS:
-						*reinterpret_cast<SINT64*>(to.dsc_address) = rpb->rpb_transaction_nr;
-						break;
-					case ID_DBKEY:
-						*reinterpret_cast<SINT64*>(to.dsc_address) = rpb->rpb_number.getValue();
-						break;
-					case ID_DBKEY_VALID:
-						*to.dsc_address = (UCHAR) rpb->rpb_number.isValid();
-						break;
-					default:
-						fb_assert(false);
-					}
-					continue;
-				}
+	impure->irsb_sort = scb.release();
+}
 
-				if (!EVL_field(rpb->rpb_relation, rpb->rpb_record, item->fieldId, from))
-					flag = true;
-			}
+void SortedStream::initParallel(thread_db* tdbb, Impure* impure, int workers, Sort* first) const
+{
+	Database* const dbb = tdbb->getDatabase();
+	Request* const request = tdbb->getRequest();
+	MemoryPool& pool = request->req_sorts.getPool();
 
-			*(data + item->flagOffset) = flag ? TRUE : FALSE;
+	AutoPtr<PartitionedSort> partitions(FB_NEW_POOL(pool) PartitionedSort(dbb, &request->req_sorts, true));
+	partitions->addPartition(first);
 
-			if (!flag)
+	// The input stream is evaluated in the context of this request, so it's
+	// still pumped here. The records already put into the first sort stay there.
+	// Sort records are built into batch buffers and the full batches are put into
+	// up to "workers" partition sorts by parallel workers while the next batches
+	// are being built.
+
+	const ULONG length = m_map->length;
+	const ULONG batchCount = MAX(PARTITION_BATCH_SIZE / length, 1);
+	const ULONG batchSize = batchCount * length;
+
+	SortPartitionTask task(dbb, pool, length, batchSize, workers);
+
+	for (int i = 0; i < workers; i++)
+	{
+		AutoPtr<Sort> sort(FB_NEW_POOL(pool)
+			Sort(dbb, &request->req_sorts,
+				 m_map->length, m_map->keyItems.getCount(), m_map->keyItems.getCount(),
+				 m_map->keyItems.begin(),
+				 ((m_map->flags & FLAG_PROJECT) ? rejectDuplicate : nullptr), 0));
+
+		task.addPartition(sort);
+		partitions->addPartition(sort.release());
+	}
+
+	Thread::Handle thread = 0;
+	Thread::start(SortPartitionTask::run, &task, THREAD_medium, &thread);
+
+	try
+	{
+		UCHAR* batch = task.getBuffer(tdbb);
+		ULONG count = 0;
+
+		while (batch && m_next->getRecord(tdbb))
+		{
+			if (count == batchCount)
 			{
-				// If an INTL string is moved into the key portion of the sort record,
-				// then we want to sort by language dependent order
+				task.putBatch(batch, count * length);
+				count = 0;
 
-				if (IS_INTL_DATA(&item->desc) && isKey(&item->desc))
-				{
-					INTL_string_to_key(tdbb, INTL_INDEX_TYPE(&item->desc), from, &to,
-						(m_map->flags & FLAG_UNIQUE ? INTL_KEY_UNIQUE : INTL_KEY_SORT));
-				}
-				else
+				// Workers have failed, their error is reported below
+				if (!(batch = task.getBuffer(tdbb)))
+					break;
+			}
+
+			buildRecord(tdbb, request, batch + count * length);
+			count++;
+		}
+
+		if (batch && count)
+			task.putBatch(batch, count * length);
+
+		task.finish();
+
+		// The first partition is sorted here while the workers sort the rest
+		first->sort(tdbb);
+	}
+	catch (const Exception&)
+	{
+		task.stop();
+
+		EngineCheckout cout(tdbb, FB_FUNCTION);
+		Thread::waitForCompletion(thread);
+
+		throw;
+	}
+
+	{
+		EngineCheckout cout(tdbb, FB_FUNCTION);
+		Thread::waitForCompletion(thread);
+	}
+
+	FbLocalStatus localStatus;
+
+	if (!task.getResult(&localStatus))
+		localStatus.raise();
+
+	partitions->buildMergeTree();
+
+	impure->irsb_partitions = partitions.release();
+}
+
+void SortedStream::buildRecord(thread_db* tdbb, Request* request, UCHAR* data) const
+{
+	// Zero out the sort key. This solves a multitude of problems.
+
+	memset(data, 0, m_map->length);
+
+	dsc to, temp;
+
+	// Loop thru all field (keys and hangers on) involved in the sort.
+	// Be careful to null field all unused bytes in the sort key.
+
+	const SortMap::Item* const end_item = m_map->items.begin() + m_map->items.getCount();
+	for (const SortMap::Item* item = m_map->items.begin(); item < end_item; item++)
+	{
+		to = item->desc;
+		to.dsc_address = data + (IPTR) to.dsc_address;
+		bool flag = false;
+		dsc* from = nullptr;
+
+		if (item->node)
+		{
+			from = EVL_expr(tdbb, request, item->node);
+			if (request->req_flags & req_null)
+				flag = true;
+		}
+		else
+		{
+			from = &temp;
+
+			record_param* const rpb = &request->req_rpb[item->stream];
+
+			if (item->fieldId < 0)
+			{
+				switch (item->fieldId)
 				{
-					MOV_move(tdbb, from, &to);
+				case ID_TRANS:
+					*reinterpret_cast<SINT64*>(to.dsc_address) = rpb->rpb_transaction_nr;
+					break;
+				case ID_DBKEY:
+					*reinterpret_cast<SINT64*>(to.dsc_address) = rpb->rpb_number.getValue();
+					break;
+				case ID_DBKEY_VALID:
+					*to.dsc_address = (UCHAR) rpb->rpb_number.isValid();
+					break;
+				default:
+					fb_assert(false);
 				}
+				continue;
 			}
+
+			if (!EVL_field(rpb->rpb_relation, rpb->rpb_record, item->fieldId, from))
+				flag = true;
 		}
-	}
 
-	scb->sort(tdbb);
+		*(data + item->flagOffset) = flag ? TRUE : FALSE;
 
-	return scb.release();
+		if (!flag)
+		{
+			// If an INTL string is moved into the key portion of the sort record,
+			// then we want to sort by language dependent order
+
+			if (IS_INTL_DATA(&item->desc) && isKey(&item->desc))
+			{
+				INTL_string_to_key(tdbb, INTL_INDEX_TYPE(&item->desc), from, &to,
+					(m_map->flags & FLAG_UNIQUE ? INTL_KEY_UNIQUE : INTL_KEY_SORT));
+			}
+			else
+			{
+				MOV_move(tdbb, from, &to);
+			}
+		}
+	}
 }
 
 bool SortedStream::compareKeys(const UCHAR* p, const UCHAR* q) const
@@ -336,7 +768,11 @@ UCHAR* SortedStream::getData(thread_db* tdbb) const
 	Impure* const impure = request->getImpure<Impure>(m_impure);
 
 	ULONG* data = nullptr;
-	impure->irsb_sort->get(tdbb, &data);
+
+	if (impure->irsb_partitions)
+		impure->irsb_partitions->get(tdbb, &data);
+	else
+		impure->irsb_sort->get(tdbb, &data);
 
 	return reinterpret_cast<UCHAR*>(data);
 }
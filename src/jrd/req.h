@@ -119,6 +119,7 @@ const USHORT rpb_gc_active		= 256;		// garbage collecting dead record version
 const USHORT rpb_uk_modified	= 512;		// record key field values are changed
 const USHORT rpb_long_tranum	= 1024;		// transaction number is 64-bit
 const USHORT rpb_not_packed		= 2048;		// record (or delta) is stored "as is"
+const USHORT rpb_lz_packed		= 4096;		// record (or delta) is LZ compressed
 
 // Stream flags
 
@@ -128,6 +129,8 @@ const USHORT RPB_s_sweeper	= 0x04;	// garbage collector - skip swept pages
 const USHORT RPB_s_unstable = 0x08;	// don't use undo log, used with unstable explicit cursors
 const USHORT RPB_s_bulk		= 0x10;	// bulk operation (currently insert only)
 const USHORT RPB_s_skipLocked = 0x20;	// skip locked record
+const USHORT RPB_s_keyed	= 0x40;	// record keys are used by positioned updates
+const USHORT RPB_s_bulk_index = 0x80;	// keys of non-unique indices may be deferred
 
 // Runtime flags
 
@@ -171,6 +174,15 @@ struct RecordKey
 	TraNumber recordVersion;
 };
 
+// Source of messages for a request executing in batch mode. It allows the request
+// to receive the next message without stalling, i.e. without leaving the looper.
+
+class BatchMessageSource
+{
+public:
+	virtual bool getMessage(thread_db* tdbb, UCHAR* buffer, ULONG length) = 0;
+};
+
 // request block
 
 class Request : public pool_alloc<type_req>
@@ -334,7 +346,8 @@ public:
 		  req_auto_trans(*req_pool),
 		  req_sorts(*req_pool, attachment->att_database),
 		  req_rpb(*req_pool),
-		  impureArea(*req_pool)
+		  impureArea(*req_pool),
+		  req_batch_source(NULL)
 	{
 		fb_assert(statement);
 		setAttachment(attachment);
@@ -458,6 +471,7 @@ public:
 	SnapshotData req_snapshot;
 	StatusXcp req_last_xcp;			// last known exception
 	bool req_batch_mode;
+	BatchMessageSource* req_batch_source;	// Messages to execute in the same looper run
 
 	enum req_s {
 		req_evaluate,
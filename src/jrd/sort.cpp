@@ -79,6 +79,12 @@ using namespace Firebird;
 const ULONG MAX_SORT_BUFFER_SIZE = 1024 * 128;	// 128KB
 const ULONG MIN_RECORDS_TO_ALLOC = 8;
 
+// Buffers with at least this number of records are sorted using
+// the radix pass over the key prefixes, see Sort::radix()
+const ULONG MIN_RADIX_RECORDS = 512;
+// Radix intervals smaller than this are finished by the insertion sort
+const ULONG MIN_RADIX_INTERVAL = 32;
+
 // the size of sr_bckptr (everything before sort_record) in bytes
 #define SIZEOF_SR_BCKPTR offsetof(sr, sr_sort_record)
 // the size of sr_bckptr in # of 32 bit longwords
@@ -147,6 +153,21 @@ namespace
 		*a = *b;
 		*b = temp;
 	}
+
+	// Record pointer accompanied by the first 64 bits of its (diddled) key
+
+	struct PrefixItem
+	{
+		FB_UINT64 prefix;
+		SORTP* record;
+	};
+
+	struct RadixInterval
+	{
+		ULONG start;
+		ULONG count;
+		int shift;
+	};
 } // namespace
 
 
@@ -1857,6 +1878,123 @@ void Sort::quick(SLONG size, SORTP** pointers, ULONG length)
 }
 
 
+void Sort::radix(ULONG size, SORTP** pointers)
+{
+/**************************************
+ *
+ * Sort an array of record pointers using the MSD radix sort over
+ * the key prefixes. The first two longwords of every key are copied
+ * next to the record pointer, so the radix passes don't touch the
+ * records at all. Only the groups of records having equal prefixes
+ * are passed to the quick sort which compares the whole keys.
+ *
+ * The same assumptions as for quick() apply. Note that the array
+ * requires the same final pass to unscramble pairs.
+ *
+ **************************************/
+	const ULONG keyLongs = m_longs - SIZEOF_SR_BCKPTR_IN_LONGS;
+
+	Array<PrefixItem> buffer(m_owner->getPool());
+	PrefixItem* const items = buffer.getBuffer(size * 2);
+	PrefixItem* const temp = items + size;
+
+	for (ULONG n = 0; n < size; n++)
+	{
+		SORTP* const record = pointers[n];
+		items[n].prefix = ((FB_UINT64) record[0] << 32) | (keyLongs > 1 ? record[1] : 0);
+		items[n].record = record;
+	}
+
+	HalfStaticArray<RadixInterval, 64> stack(m_owner->getPool());
+	stack.push({0, size, 56});
+
+	while (stack.hasData())
+	{
+		const RadixInterval interval = stack.pop();
+		PrefixItem* const base = items + interval.start;
+
+		if (interval.count < MIN_RADIX_INTERVAL)
+		{
+			for (ULONG i = 1; i < interval.count; i++)
+			{
+				const PrefixItem item = base[i];
+				ULONG k = i;
+
+				for (; k && base[k - 1].prefix > item.prefix; k--)
+					base[k] = base[k - 1];
+
+				base[k] = item;
+			}
+
+			continue;
+		}
+
+		ULONG counts[256];
+		memset(counts, 0, sizeof(counts));
+
+		for (ULONG i = 0; i < interval.count; i++)
+			counts[(base[i].prefix >> interval.shift) & 0xFF]++;
+
+		ULONG offsets[256];
+		ULONG offset = 0;
+
+		for (ULONG b = 0; b < 256; b++)
+		{
+			offsets[b] = offset;
+			offset += counts[b];
+		}
+
+		// Skip the data movement if all prefixes share the same byte
+
+		if (counts[(base[0].prefix >> interval.shift) & 0xFF] != interval.count)
+		{
+			for (ULONG i = 0; i < interval.count; i++)
+				temp[offsets[(base[i].prefix >> interval.shift) & 0xFF]++] = base[i];
+
+			memcpy(base, temp, interval.count * sizeof(PrefixItem));
+		}
+
+		if (!interval.shift)
+			continue;
+
+		offset = interval.start;
+
+		for (ULONG b = 0; b < 256; b++)
+		{
+			if (counts[b] > 1)
+				stack.push({offset, counts[b], interval.shift - 8});
+
+			offset += counts[b];
+		}
+	}
+
+	// Put the ordered pointers back and fix the back pointers of the records
+
+	for (ULONG n = 0; n < size; n++)
+	{
+		pointers[n] = items[n].record;
+		((SORTP***) pointers[n])[BACK_OFFSET] = pointers + n;
+	}
+
+	// Order the groups of equal prefixes by their whole keys. The first key
+	// longword is the same within the group and the next group (or the high key
+	// guard) is greater, so the group is properly bounded for quick().
+
+	for (ULONG start = 0; start < size; )
+	{
+		ULONG end = start + 1;
+
+		while (end < size && items[end].prefix == items[start].prefix)
+			end++;
+
+		if (end - start > 2)
+			quick(end - start, pointers + start, m_longs);
+
+		start = end;
+	}
+}
+
+
 ULONG Sort::order()
 {
 /**************************************
@@ -1955,7 +2093,10 @@ void Sort::orderAndSave(thread_db* tdbb)
  * scratch file as one big chunk
  *
  **************************************/
-	EngineCheckout cout(tdbb, FB_FUNCTION);
+	// Partitions of a parallel sort are processed by workers without an attachment,
+	// there is nothing to check out then
+	EngineCheckout cout(tdbb, FB_FUNCTION,
+		tdbb->getAttachment() ? EngineCheckout::REQUIRED : EngineCheckout::AVOID);
 
 	run_control* run = m_runs;
 	run->run_records = 0;
@@ -2051,7 +2192,10 @@ void Sort::sortBuffer(thread_db* tdbb)
  * been requested, detect and handle them.
  *
  **************************************/
-	EngineCheckout cout(tdbb, FB_FUNCTION);
+	// Partitions of a parallel sort are processed by workers without an attachment,
+	// there is nothing to check out then
+	EngineCheckout cout(tdbb, FB_FUNCTION,
+		tdbb->getAttachment() ? EngineCheckout::REQUIRED : EngineCheckout::AVOID);
 
 	// First, insert a pointer to the high key
 
@@ -2063,7 +2207,10 @@ void Sort::sortBuffer(thread_db* tdbb)
 	SORTP** j = (SORTP**) (m_first_pointer) + 1;
 	const ULONG n = (SORTP**) (m_next_pointer) - j;	// calculate # of records
 
-	quick(n, j, m_longs);
+	if (n >= MIN_RADIX_RECORDS)
+		radix(n, j);
+	else
+		quick(n, j, m_longs);
 
 	// Scream through and correct any out of order pairs
 	// hvlad: don't compare user keys against high_key
@@ -2167,54 +2314,47 @@ void Sort::sortRunsBySeek(int n)
 
 UCHAR* SortOwner::allocateBuffer()
 {
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
 	if (buffers.hasData())
 		return buffers.pop();
 
-	if (dbb->dbb_sort_buffers.hasData())
-	{
-		SyncLockGuard guard(&dbb->dbb_sortbuf_sync, SYNC_EXCLUSIVE, FB_FUNCTION);
-
-		// The sort buffer cache has at least one big block, let's use it
-		if (dbb->dbb_sort_buffers.hasData())
-			return dbb->dbb_sort_buffers.pop();
-	}
-
-	return nullptr;
+	return dbb->dbb_sort_buffers.get();
 }
 
 void SortOwner::releaseBuffer(UCHAR* memory)
 {
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
 	buffers.push(memory);
 }
 
 
 void SortOwner::unlinkAll()
 {
+	MutexLockGuard guard(mutex, FB_FUNCTION);
+
 	while (sorts.getCount())
 		delete sorts.pop();
 
-	if (buffers.hasData())
-	{
-		// Move cached buffers to the database level cache to be reused later by other attachments
+	// Move cached buffers to the database level cache to be reused later by other attachments
 
-		const size_t MAX_CACHED_SORT_BUFFERS = 8; // 1MB
-
-		SyncLockGuard guard(&dbb->dbb_sortbuf_sync, SYNC_EXCLUSIVE, FB_FUNCTION);
+	while (buffers.hasData())
+	{
+		UCHAR* const buffer = buffers.pop();
 
-		while (buffers.hasData() && dbb->dbb_sort_buffers.getCount() < MAX_CACHED_SORT_BUFFERS)
-			dbb->dbb_sort_buffers.push(buffers.pop());
+		if (!dbb->dbb_sort_buffers.put(buffer))
+			delete[] buffer;
 	}
-
-	while (buffers.hasData())
-		delete[] buffers.pop();
 }
 
 
 /// class PartitionedSort
 
 
-PartitionedSort::PartitionedSort(Database* dbb, SortOwner* owner) :
+PartitionedSort::PartitionedSort(Database* dbb, SortOwner* owner, bool ownParts) :
 	m_owner(owner),
+	m_ownParts(ownParts),
 	m_parts(owner->getPool()),
 	m_nodes(owner->getPool()),
 	m_merge(NULL)
@@ -2223,8 +2363,11 @@ PartitionedSort::PartitionedSort(Database* dbb, SortOwner* owner) :
 
 PartitionedSort::~PartitionedSort()
 {
-//	for (ULONG p = 0; p < m_parts.getCount(); p++)
-//		delete m_parts[p].srt_sort;
+	if (m_ownParts)
+	{
+		for (ULONG p = 0; p < m_parts.getCount(); p++)
+			delete m_parts[p].srt_sort;
+	}
 }
 
 void PartitionedSort::buildMergeTree()
@@ -28,6 +28,7 @@
 #include "../common/DecFloat.h"
 #include "../jrd/TempSpace.h"
 #include "../jrd/align.h"
+#include "../common/classes/locks.h"
 
 namespace Jrd {
 
@@ -291,6 +292,12 @@ public:
 		return m_flags & scb_sorted;
 	}
 
+	// Records didn't fit into the sort memory and were written to scratch file
+	bool hasRuns() const
+	{
+		return m_runs != NULL;
+	}
+
 	static FB_UINT64 readBlock(TempSpace* space, FB_UINT64 seek, UCHAR* address, ULONG length)
 	{
 		const size_t bytes = space->read(seek, address, length);
@@ -318,6 +325,7 @@ private:
 	ULONG order();
 	void orderAndSave(Jrd::thread_db*);
 	void putRun(Jrd::thread_db*);
+	void radix(ULONG, SORTP**);
 	void sortBuffer(Jrd::thread_db*);
 	void sortRunsBySeek(int);
 
@@ -359,7 +367,7 @@ private:
 class PartitionedSort
 {
 public:
-	PartitionedSort(Database*, SortOwner*);
+	PartitionedSort(Database*, SortOwner*, bool ownParts = false);
 	~PartitionedSort();
 
 	void get(Jrd::thread_db*, ULONG**);
@@ -380,6 +388,7 @@ private:
 	sort_record* getMerge();
 
 	SortOwner* m_owner;
+	const bool m_ownParts;				// partitions are deleted along with this object
 	Firebird::HalfStaticArray<sort_control, 8> m_parts;
 	Firebird::HalfStaticArray<merge_control, 8> m_nodes;	// nodes of merge tree
 	merge_control* m_merge;				// root of merge tree
@@ -404,6 +413,8 @@ public:
 	{
 		fb_assert(scb);
 
+		Firebird::MutexLockGuard guard(mutex, FB_FUNCTION);
+
 		if (!sorts.exist(scb))
 		{
 			sorts.add(scb);
@@ -414,6 +425,8 @@ public:
 	{
 		fb_assert(scb);
 
+		Firebird::MutexLockGuard guard(mutex, FB_FUNCTION);
+
 		FB_SIZE_T pos;
 		if (sorts.find(scb, pos))
 		{
@@ -432,6 +445,7 @@ public:
 private:
 	MemoryPool& pool;
 	Database* const dbb;
+	Firebird::Mutex mutex;		// partitions of a parallel sort are sorted by several threads
 	Firebird::SortedArray<Sort*> sorts;
 	Firebird::HalfStaticArray<UCHAR*, 4> buffers;
 };
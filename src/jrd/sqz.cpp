@@ -47,6 +47,24 @@ using namespace Jrd;
 // they do not compress much but increase total number of runs thus affecting decompression speed.
 // Starting from Firebird v5, we don't compress runs shorter than 8 bytes. But this rule is not
 // set in stone, so let's not use lengths between 4 and 7 bytes as some other special markers.
+//
+// Alternative (LZ) scheme, used for records flagged with rhd_lz_packed:
+//
+// {four-byte unpacked length} {sequence} ...
+//
+// Every sequence starts with a token byte: its upper nibble is the number of literal bytes,
+// its lower nibble is the match length minus LZ_MIN_MATCH. Nibble value 15 means the length
+// is continued by the following bytes, each of them adding up to 255 (a byte less than 255
+// terminates the length). The literal bytes follow, then a two-byte backward offset
+// of the match and the continuation of the match length, if any. The last sequence
+// contains literals only, decoding stops as soon as the unpacked length is reached,
+// so the trailing zero padding (if any) is ignored.
+//
+// The scheme is a part of the on-disk format, so it's implemented here rather than taken
+// from the LZ4 or zstd libraries used for the wire compression (see common/classes/zip.h):
+// those are loaded at runtime and may be missing, while a database must stay readable by
+// any server supporting its ODS. Their frame formats also add a header and checksums to
+// every record, which costs more than it saves for the typical record size.
 
 namespace
 {
@@ -63,6 +81,109 @@ namespace
 		return (length <= MAX_SHORT_RUN) ? 0 :
 			(length <= MAX_MEDIUM_RUN) ? sizeof(USHORT) : sizeof(ULONG);
 	}
+
+	const unsigned LZ_MIN_MATCH = 4;		// shortest match worth encoding
+	const unsigned LZ_LAST_LITERALS = 5;	// trailing bytes always stored as literals
+	const unsigned LZ_MIN_INPUT = 16;		// shorter inputs are never LZ compressed
+	const unsigned LZ_MAX_OFFSET = MAX_USHORT;
+	const unsigned LZ_HASH_BITS = 12;
+	const unsigned LZ_HEADER_SIZE = sizeof(ULONG);
+	const unsigned LZ_LENGTH_MASK = 15;
+
+	inline ULONG lzRead(const UCHAR* p)
+	{
+		ULONG value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline unsigned lzHash(ULONG value)
+	{
+		return (value * 2654435761U) >> (32 - LZ_HASH_BITS);
+	}
+
+	inline UCHAR* lzPutLength(UCHAR* output, unsigned length)
+	{
+		for (; length >= MAX_UCHAR; length -= MAX_UCHAR)
+			*output++ = MAX_UCHAR;
+
+		*output++ = (UCHAR) length;
+		return output;
+	}
+
+	inline unsigned lzGetLength(const UCHAR*& input, const UCHAR* end, unsigned length)
+	{
+		if (length == LZ_LENGTH_MASK)
+		{
+			UCHAR c;
+
+			do
+			{
+				if (input >= end)
+					BUGCHECK(179);	// msg 179 decompression overran buffer
+
+				c = *input++;
+				length += c;
+			} while (c == MAX_UCHAR);
+		}
+
+		return length;
+	}
+
+	UCHAR* lzUnpack(ULONG inLength, const UCHAR* input, ULONG outLength, UCHAR* output)
+	{
+		if (inLength < LZ_HEADER_SIZE)
+			BUGCHECK(179);	// msg 179 decompression overran buffer
+
+		const auto end = input + inLength;
+		const auto start = output;
+		const ULONG length = get_long(input);
+		input += LZ_HEADER_SIZE;
+
+		if (length > outLength)
+			BUGCHECK(179);	// msg 179 decompression overran buffer
+
+		const auto output_end = output + length;
+
+		while (output < output_end)
+		{
+			if (input >= end)
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+
+			const unsigned token = *input++;
+
+			const auto literals = lzGetLength(input, end, token >> 4);
+
+			if (input + literals > end || output + literals > output_end)
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+
+			memcpy(output, input, literals);
+			output += literals;
+			input += literals;
+
+			if (output == output_end)
+				break;
+
+			if (input + sizeof(USHORT) > end)
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+
+			const unsigned offset = get_short(input);
+			input += sizeof(USHORT);
+
+			const auto match = lzGetLength(input, end, token & LZ_LENGTH_MASK) + LZ_MIN_MATCH;
+
+			if (!offset || offset > (ULONG) (output - start) || output + match > output_end)
+				BUGCHECK(179);	// msg 179 decompression overran buffer
+
+			// Matches may overlap the bytes being produced, so copy them one by one
+
+			const UCHAR* from = output - offset;
+			for (const auto stop = output + match; output < stop;)
+				*output++ = *from++;
+		}
+
+		return output;
+	}
 };
 
 unsigned Compressor::nonCompressableRun(unsigned length)
@@ -92,18 +213,23 @@ unsigned Compressor::nonCompressableRun(unsigned length)
 	return result;
 }
 
-Compressor::Compressor(thread_db* tdbb, ULONG length, const UCHAR* data)
+Compressor::Compressor(thread_db* tdbb, ULONG length, const UCHAR* data, bool allowLz)
 	: Compressor(
 		*tdbb->getDefaultPool(),
 		tdbb->getDatabase()->getEncodedOdsVersion() >= ODS_13_1,
 		tdbb->getDatabase()->getEncodedOdsVersion() >= ODS_13_1,
 		length,
-		data)
+		data,
+		allowLz &&
+			tdbb->getDatabase()->getEncodedOdsVersion() >= ODS_14_1 &&
+			tdbb->getDatabase()->dbb_config->getLZRecordCompression())
 {
 }
 
-Compressor::Compressor(MemoryPool& pool, bool allowLongRuns, bool allowUnpacked, ULONG length, const UCHAR* data)
+Compressor::Compressor(MemoryPool& pool, bool allowLongRuns, bool allowUnpacked, ULONG length, const UCHAR* data,
+					   bool allowLz)
 	: m_runs(pool),
+	  m_lzData(pool),
 	  m_allowLongRuns(allowLongRuns),
 	  m_allowUnpacked(allowUnpacked)
 {
@@ -208,6 +334,120 @@ Compressor::Compressor(MemoryPool& pool, bool allowLongRuns, bool allowUnpacked,
 		m_runs.clear();
 		m_length = length;
 	}
+
+	m_rleLength = m_length;
+
+	if (allowLz && length >= LZ_MIN_INPUT)
+		lzCompress(length, input);
+}
+
+void Compressor::lzCompress(ULONG length, const UCHAR* data)
+{
+/**************************************
+ *
+ *	Build the LZ image of the input and keep it
+ *	if it's shorter than the RLE one.
+ *
+ **************************************/
+	ULONG hashTable[1 << LZ_HASH_BITS];
+	memset(hashTable, 0, sizeof(hashTable));
+
+	// Worst case is all literals plus their length continuation bytes
+
+	const ULONG maxLength = LZ_HEADER_SIZE + 1 + length + length / MAX_UCHAR + 1;
+	UCHAR* const buffer = m_lzData.getBuffer(maxLength, false);
+	UCHAR* output = buffer;
+
+	put_long(output, length);
+	output += LZ_HEADER_SIZE;
+
+	const auto limit = length - LZ_LAST_LITERALS;
+	ULONG anchor = 0, pos = 0;
+
+	while (pos + LZ_MIN_MATCH <= limit)
+	{
+		const auto value = lzRead(data + pos);
+		auto& slot = hashTable[lzHash(value)];
+		const auto candidate = slot;
+		slot = pos + 1;		// zero means an empty slot
+
+		if (!candidate || pos - (candidate - 1) > LZ_MAX_OFFSET || lzRead(data + candidate - 1) != value)
+		{
+			pos++;
+			continue;
+		}
+
+		const auto ref = candidate - 1;
+		auto match = LZ_MIN_MATCH;
+
+		while (pos + match < limit && data[ref + match] == data[pos + match])
+			match++;
+
+		const auto literals = pos - anchor;
+		const auto extraMatch = match - LZ_MIN_MATCH;
+
+		UCHAR* const token = output++;
+		*token = (UCHAR) ((MIN(literals, LZ_LENGTH_MASK) << 4) | MIN(extraMatch, LZ_LENGTH_MASK));
+
+		if (literals >= LZ_LENGTH_MASK)
+			output = lzPutLength(output, literals - LZ_LENGTH_MASK);
+
+		memcpy(output, data + anchor, literals);
+		output += literals;
+
+		put_short(output, (USHORT) (pos - ref));
+		output += sizeof(USHORT);
+
+		if (extraMatch >= LZ_LENGTH_MASK)
+			output = lzPutLength(output, extraMatch - LZ_LENGTH_MASK);
+
+		pos += match;
+		anchor = pos;
+
+		// Stop as soon as RLE is known to be better
+
+		if ((ULONG) (output - buffer) >= m_rleLength)
+			break;
+	}
+
+	if ((ULONG) (output - buffer) < m_rleLength)
+	{
+		const auto literals = length - anchor;
+
+		*output++ = (UCHAR) (MIN(literals, LZ_LENGTH_MASK) << 4);
+
+		if (literals >= LZ_LENGTH_MASK)
+			output = lzPutLength(output, literals - LZ_LENGTH_MASK);
+
+		memcpy(output, data + anchor, literals);
+		output += literals;
+	}
+
+	const ULONG lzLength = output - buffer;
+	fb_assert(lzLength <= maxLength);
+
+	if (lzLength < m_rleLength)
+	{
+		m_lzData.shrink(lzLength);
+		m_length = lzLength;
+	}
+	else
+		m_lzData.clear();
+}
+
+void Compressor::discardLz()
+{
+/**************************************
+ *
+ *	Fall back to RLE. The LZ image is always decoded as a whole,
+ *	so it cannot be split between record fragments.
+ *
+ **************************************/
+	if (m_lzData.hasData())
+	{
+		m_lzData.clear();
+		m_length = m_rleLength;
+	}
 }
 
 void Compressor::pack(const UCHAR* input, UCHAR* output) const
@@ -218,6 +458,12 @@ void Compressor::pack(const UCHAR* input, UCHAR* output) const
  *	Don't check nuttin' -- go for speed, man, raw SPEED!
  *
  **************************************/
+	if (m_lzData.hasData())
+	{
+		memcpy(output, m_lzData.begin(), m_lzData.getCount());
+		return;
+	}
+
 	if (m_runs.isEmpty())
 	{
 		// Perform raw byte copying instead of compressing
@@ -273,6 +519,7 @@ ULONG Compressor::truncate(ULONG outLength)
  *	Return the number of leading input bytes that fit the given output length.
  *
  **************************************/
+	discardLz();
 	fb_assert(m_length > outLength);
 
 	if (m_runs.isEmpty())
@@ -345,6 +592,7 @@ ULONG Compressor::truncateTail(ULONG outLength)
  *	Return the number of trailing input bytes that fit the given output length.
  *
  **************************************/
+	discardLz();
 	fb_assert(m_length > outLength);
 
 	if (m_runs.isEmpty())
@@ -414,13 +662,16 @@ ULONG Compressor::truncateTail(ULONG outLength)
 	return inLength;
 }
 
-ULONG Compressor::getUnpackedLength(ULONG inLength, const UCHAR* input)
+ULONG Compressor::getUnpackedLength(ULONG inLength, const UCHAR* input, bool lzPacked)
 {
 /**************************************
  *
  *	Calculate the unpacked length of the input compressed string.
  *
  **************************************/
+	if (lzPacked)
+		return (inLength >= LZ_HEADER_SIZE) ? get_long(input) : 0;
+
 	const auto end = input + inLength;
 	ULONG result = 0;
 
@@ -460,7 +711,7 @@ ULONG Compressor::getUnpackedLength(ULONG inLength, const UCHAR* input)
 }
 
 UCHAR* Compressor::unpack(ULONG inLength, const UCHAR* input,
-						  ULONG outLength, UCHAR* output)
+						  ULONG outLength, UCHAR* output, bool lzPacked)
 {
 /**************************************
  *
@@ -468,6 +719,9 @@ UCHAR* Compressor::unpack(ULONG inLength, const UCHAR* input,
  *	Return the address where the output stopped.
  *
  **************************************/
+	if (lzPacked)
+		return lzUnpack(inLength, input, outLength, output);
+
 	const auto end = input + inLength;
 	const auto output_end = output + outLength;
 
@@ -34,8 +34,9 @@ namespace Jrd
 	class Compressor
 	{
 	public:
-		Compressor(thread_db* tdbb, ULONG length, const UCHAR* data);
-		Compressor(MemoryPool& pool, bool allowLongRuns, bool allowUnpacked, ULONG length, const UCHAR* data);
+		Compressor(thread_db* tdbb, ULONG length, const UCHAR* data, bool allowLz = false);
+		Compressor(MemoryPool& pool, bool allowLongRuns, bool allowUnpacked, ULONG length, const UCHAR* data,
+				   bool allowLz = false);
 
 		ULONG getPackedLength() const
 		{
@@ -44,22 +45,31 @@ namespace Jrd
 
 		bool isPacked() const
 		{
-			return m_runs.hasData();
+			return m_runs.hasData() || m_lzData.hasData();
+		}
+
+		bool isLzPacked() const
+		{
+			return m_lzData.hasData();
 		}
 
 		void pack(const UCHAR* input, UCHAR* output) const;
 		ULONG truncate(ULONG outLength);
 		ULONG truncateTail(ULONG outLength);
 
-		static ULONG getUnpackedLength(ULONG inLength, const UCHAR* input);
+		static ULONG getUnpackedLength(ULONG inLength, const UCHAR* input, bool lzPacked = false);
 		static UCHAR* unpack(ULONG inLength, const UCHAR* input,
-							 ULONG outLength, UCHAR* output);
+							 ULONG outLength, UCHAR* output, bool lzPacked = false);
 
 	private:
 		unsigned nonCompressableRun(unsigned length);
+		void lzCompress(ULONG length, const UCHAR* data);
+		void discardLz();
 
 		Firebird::HalfStaticArray<int, 256> m_runs;
+		Firebird::HalfStaticArray<UCHAR, 1024> m_lzData;	// LZ image, if it beats RLE
 		ULONG m_length = 0;
+		ULONG m_rleLength = 0;
 
 		// Compatibility options
 		bool m_allowLongRuns = true;
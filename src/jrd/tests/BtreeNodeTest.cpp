@@ -0,0 +1,86 @@
+#include "firebird.h"
+#include "boost/test/unit_test.hpp"
+#include "../jrd/btn.h"
+
+using namespace Firebird;
+using namespace Jrd;
+
+BOOST_AUTO_TEST_SUITE(EngineSuite)
+BOOST_AUTO_TEST_SUITE(BtreeNodeSuite)
+
+
+BOOST_AUTO_TEST_SUITE(MatchLengthTests)
+
+// Lengths around and beyond one machine word, at every alignment
+
+const FB_SIZE_T MAX_LENGTH = 3 * sizeof(FB_UINT64) + 1;
+const FB_SIZE_T MAX_OFFSET = sizeof(FB_UINT64);
+
+BOOST_AUTO_TEST_CASE(EqualTest)
+{
+	UCHAR buffer1[MAX_OFFSET + MAX_LENGTH];
+	UCHAR buffer2[MAX_OFFSET + MAX_LENGTH];
+
+	for (FB_SIZE_T i = 0; i < sizeof(buffer1); i++)
+		buffer1[i] = buffer2[i] = (UCHAR) (i * 7 + 1);
+
+	for (FB_SIZE_T offset = 0; offset < MAX_OFFSET; offset++)
+	{
+		for (FB_SIZE_T length = 0; length <= MAX_LENGTH; length++)
+		{
+			BOOST_TEST(matchLength(buffer1 + offset, buffer2 + offset, length) == length);
+			BOOST_TEST(matchLength(buffer1 + offset, buffer1 + offset, length) == length);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(MismatchTest)
+{
+	UCHAR buffer1[MAX_OFFSET + MAX_LENGTH];
+	UCHAR buffer2[MAX_OFFSET + MAX_LENGTH];
+
+	for (FB_SIZE_T offset1 = 0; offset1 < MAX_OFFSET; offset1++)
+	{
+		// Misaligned relative to each other as well
+
+		const FB_SIZE_T offset2 = (offset1 * 3 + 1) % MAX_OFFSET;
+
+		for (FB_SIZE_T length = 1; length <= MAX_LENGTH; length++)
+		{
+			for (FB_SIZE_T pos = 0; pos < length; pos++)
+			{
+				memset(buffer1, 0xA5, sizeof(buffer1));
+				memset(buffer2, 0xA5, sizeof(buffer2));
+
+				buffer2[offset2 + pos] = 0x5A;
+
+				BOOST_TEST(matchLength(buffer1 + offset1, buffer2 + offset2, length) == pos);
+				BOOST_TEST(matchLength(buffer2 + offset2, buffer1 + offset1, length) == pos);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(BoundTest)
+{
+	// Bytes past the given length must not be compared
+
+	UCHAR buffer1[MAX_LENGTH + 1];
+	UCHAR buffer2[MAX_LENGTH + 1];
+
+	for (FB_SIZE_T length = 0; length <= MAX_LENGTH; length++)
+	{
+		memset(buffer1, 0, sizeof(buffer1));
+		memset(buffer2, 0, sizeof(buffer2));
+
+		buffer2[length] = 1;
+
+		BOOST_TEST(matchLength(buffer1, buffer2, length) == length);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()	// MatchLengthTests
+
+
+BOOST_AUTO_TEST_SUITE_END()	// BtreeNodeSuite
+BOOST_AUTO_TEST_SUITE_END()	// EngineSuite
@@ -1,5 +1,6 @@
 #include "firebird.h"
 #include "boost/test/unit_test.hpp"
+#include "../common/classes/fb_string.h"
 #include "../jrd/sqz.h"
 
 using namespace Firebird;
@@ -33,6 +34,69 @@ BOOST_AUTO_TEST_CASE(PackAndUnpackTest)
 	BOOST_TEST(memcmp(data, unpackBuffer.begin(), dataLength) == 0);
 }
 
+BOOST_AUTO_TEST_CASE(LzPackAndUnpackTest)
+{
+	auto& pool = *getDefaultMemoryPool();
+
+	// Textual data with repeating fragments but no long runs of equal bytes
+	string text;
+	for (unsigned i = 0; i < 50; ++i)
+		text.append("{\"id\": 1234, \"name\": \"firebird\", \"tags\": [\"sql\", \"db\"]}, ");
+
+	const auto data = reinterpret_cast<const UCHAR*>(text.c_str());
+	const auto dataLength = text.length();
+
+	const Compressor rle(pool, true, true, dataLength, data);
+	const Compressor dcc(pool, true, true, dataLength, data, true);
+
+	BOOST_TEST(dcc.isPacked());
+	BOOST_TEST(dcc.isLzPacked());
+	BOOST_TEST(dcc.getPackedLength() < rle.getPackedLength());
+
+	const auto packedLength = dcc.getPackedLength();
+	Array<UCHAR> packBuffer;
+	dcc.pack(data, packBuffer.getBuffer(packedLength, false));
+
+	// Trailing zero padding must be ignored
+	packBuffer.add(0);
+	packBuffer.add(0);
+
+	Array<UCHAR> unpackBuffer;
+	unpackBuffer.getBuffer(Compressor::getUnpackedLength(packBuffer.getCount(), packBuffer.begin(), true), false);
+	BOOST_TEST(unpackBuffer.getCount() == dataLength);
+
+	BOOST_TEST(Compressor::unpack(packBuffer.getCount(), packBuffer.begin(),
+		unpackBuffer.getCount(), unpackBuffer.begin(), true) == unpackBuffer.end());
+
+	BOOST_TEST(memcmp(data, unpackBuffer.begin(), dataLength) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(LzFallbackTest)
+{
+	auto& pool = *getDefaultMemoryPool();
+
+	// Long runs are better handled by RLE
+	UCHAR data[1000];
+	memset(data, 'x', sizeof(data));
+
+	Compressor dcc(pool, true, true, sizeof(data), data, true);
+	BOOST_TEST(dcc.isPacked());
+	BOOST_TEST(!dcc.isLzPacked());
+
+	// Fragmenting a record reverts it to RLE
+	string text;
+	for (unsigned i = 0; i < 100; ++i)
+		text.append("abcdefgh");
+
+	const auto textData = reinterpret_cast<const UCHAR*>(text.c_str());
+	Compressor lz(pool, true, true, text.length(), textData, true);
+	BOOST_TEST(lz.isLzPacked());
+
+	const auto inLength = lz.truncate(lz.getPackedLength() - 1);
+	BOOST_TEST(!lz.isLzPacked());
+	BOOST_TEST(inLength <= text.length());
+}
+
 BOOST_AUTO_TEST_SUITE_END()	// CompressorTests
 
 
@@ -3796,6 +3796,7 @@ jrd_tra::~jrd_tra()
 	delete tra_mapping_list;
 	delete tra_dbcreators_list;
 	delete tra_gen_ids;
+	delete tra_bulk_keys;
 
 	if (!tra_outer)
 		delete tra_blob_space;
@@ -4002,6 +4003,11 @@ void jrd_tra::rollbackSavepoint(thread_db* tdbb, bool preserveLocks)
 {
 	if (tra_save_point && !(tra_flags & TRA_system))
 	{
+		// Keys deferred by bulk inserts are put into the indices first,
+		// so the undo removes them together with the records
+
+		IDX_flush_bulk_keys(tdbb, this);
+
 		REPL_save_cleanup(tdbb, this, tra_save_point, true);
 
 		if (tra_flags & TRA_ex_restart)
@@ -4063,6 +4069,8 @@ void jrd_tra::releaseSavepoint(thread_db* tdbb)
 {
 	if (tra_save_point && !(tra_flags & TRA_system))
 	{
+		IDX_flush_bulk_keys(tdbb, this);
+
 		REPL_save_cleanup(tdbb, this, tra_save_point, false);
 
 		Jrd::ContextPoolHolder context(tdbb, tra_pool);
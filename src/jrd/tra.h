@@ -62,6 +62,7 @@ class ArrayField;
 class Attachment;
 class DeferredWork;
 class DeferredJob;
+class BulkIndexKeys;
 class TimeZoneSnapshot;
 class UserManagement;
 class MappingList;
@@ -178,6 +179,7 @@ public:
 		tra_blob_util_map(*p),
 		tra_arrays(NULL),
 		tra_deferred_job(NULL),
+		tra_bulk_keys(NULL),
 		tra_resources(*p),
 		tra_context_vars(*p),
 		tra_lock_timeout(DEFAULT_LOCK_TIMEOUT),
@@ -283,6 +285,7 @@ public:
 	SavNumber tra_save_point_number;	// next save point number to use
 	ULONG tra_flags;
 	DeferredJob*	tra_deferred_job;	// work deferred to commit time
+	BulkIndexKeys*	tra_bulk_keys;		// index keys deferred by bulk inserts
 	ResourceList tra_resources;			// resource existence list
 	Firebird::StringMap tra_context_vars; // Context variables for the transaction
 	traRpbList* tra_rpblist;			// active record_param's of given transaction
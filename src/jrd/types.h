@@ -182,6 +182,7 @@ TYPE("INDEX_BUCKET", pag_index, nam_p_type)
 TYPE("BLOB", pag_blob, nam_p_type)
 TYPE("GENERATOR", pag_ids, nam_p_type)
 TYPE("SCN_INVENTORY", pag_scns, nam_p_type)
+TYPE("BLOCK_RANGE", pag_range, nam_p_type)
 
 TYPE("PUBLIC", 0, nam_private_flag)
 TYPE("PRIVATE", 1, nam_private_flag)
@@ -568,8 +568,10 @@ VI. ADDITIONAL NOTES
 
 #include "../common/classes/ClumpletWriter.h"
 #include "../common/db_alias.h"
+#include "../common/Task.h"
 #include "../jrd/intl_proto.h"
 #include "../jrd/lck_proto.h"
+#include "../jrd/WorkerAttachment.h"
 
 #ifdef DEBUG_VAL_VERBOSE
 #include "../jrd/dmp_proto.h"
@@ -650,6 +652,13 @@ static void explain_pp_bits(const UCHAR bits, Firebird::string& names)
 			names.append(", ");
 		names.append("empty");
 	}
+
+	if (bits & ppg_dp_all_visible)
+	{
+		if (!names.empty())
+			names.append(", ");
+		names.append("all visible");
+	}
 }
 
 
@@ -851,6 +860,276 @@ const Validation::MSG_ENTRY Validation::vdr_msg_table[VAL_MAX_ERROR] =
 	{true, isc_info_dpage_errors,	"Data page %" ULONGFORMAT" {sequence %" ULONGFORMAT"} marked as secondary but contains primary record versions"}
 };
 
+// Parallel validation of relations. Work item is a whole relation as index
+// checks need complete bitmap of relation's records. Every work item has its
+// own attachment and its own Validation instance, results of workers are
+// accounted by the validation run when all relations are walked.
+
+class ValidationTask : public Task
+{
+public:
+	ValidationTask(thread_db* tdbb, Validation* validation, const Array<USHORT>& relations,
+			int workers) : Task(),
+		m_pool(tdbb->getDefaultPool()),
+		m_dbb(tdbb->getDatabase()),
+		m_validation(validation),
+		m_items(*m_pool),
+		m_relations(*m_pool),
+		m_skipped(*m_pool),
+		m_nextRelation(0),
+		m_stop(false)
+	{
+		m_relations.assign(relations);
+
+		workers = MIN(workers, (int) m_relations.getCount());
+
+		for (int i = 0; i < workers; i++)
+			m_items.add(FB_NEW_POOL(*m_pool) Item(this));
+
+		m_items[0]->m_ownAttach = false;
+		m_items[0]->m_attStable = tdbb->getAttachment()->getStable();
+	}
+
+	virtual ~ValidationTask()
+	{
+		for (Item** p = m_items.begin(); p < m_items.end(); p++)
+			delete *p;
+	}
+
+	class Item : public Task::WorkItem
+	{
+	public:
+		Item(ValidationTask* task) : Task::WorkItem(task),
+			m_inuse(false),
+			m_ownAttach(true),
+			m_relId(0),
+			m_pool(NULL),
+			m_validation(NULL)
+		{}
+
+		virtual ~Item()
+		{
+			if (m_pool)
+			{
+				delete m_validation;
+				getValidationTask()->m_dbb->deletePool(m_pool);
+			}
+
+			if (!m_ownAttach || !m_attStable)
+				return;
+
+			{
+				AttSyncLockGuard guard(*m_attStable->getSync(), FB_FUNCTION);
+				if (!m_attStable->getHandle())
+					return;
+			}
+
+			FbLocalStatus status;
+			WorkerAttachment::releaseAttachment(&status, m_attStable);
+		}
+
+		ValidationTask* getValidationTask() const
+		{
+			return reinterpret_cast<ValidationTask*> (m_task);
+		}
+
+		bool init(thread_db* tdbb)
+		{
+			FbStatusVector* status = tdbb->tdbb_status_vector;
+
+			Attachment* att = NULL;
+
+			const bool first = !m_attStable.hasData();
+			if (m_ownAttach && first)
+				m_attStable = WorkerAttachment::getAttachment(status, getValidationTask()->m_dbb);
+
+			if (m_attStable)
+				att = m_attStable->getHandle();
+
+			if (!att)
+			{
+				Arg::Gds(isc_bad_db_handle).copyTo(status);
+				return false;
+			}
+
+			tdbb->setDatabase(att->att_database);
+			tdbb->setAttachment(att);
+
+			if (m_ownAttach && first)
+			{
+				try
+				{
+					WorkerContextHolder holder(tdbb, FB_FUNCTION);
+					DPM_scan_pages(tdbb);
+				}
+				catch (const Exception& ex)
+				{
+					ex.stuffException(tdbb->tdbb_status_vector);
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool m_inuse;
+		bool m_ownAttach;
+		RefPtr<StableAttachmentPart> m_attStable;
+		USHORT m_relId;						// relation to work on
+		MemoryPool* m_pool;					// pool of the worker's Validation
+		Validation* m_validation;
+	};
+
+	bool handler(WorkItem& _item);
+	bool getWorkItem(WorkItem** pItem);
+
+	bool getResult(IStatus* status)
+	{
+		if (status)
+		{
+			status->init();
+			status->setErrors(m_status.getErrors());
+		}
+
+		return m_status.isSuccess();
+	}
+
+	int getMaxWorkers()
+	{
+		return m_items.getCount();
+	}
+
+	// Account results of all workers, return relations left unhandled
+	const Array<USHORT>& finish()
+	{
+		for (Item** p = m_items.begin(); p < m_items.end(); p++)
+		{
+			if ((*p)->m_validation)
+				m_validation->merge(*(*p)->m_validation);
+		}
+
+		return m_skipped;
+	}
+
+private:
+	void setError(IStatus* status, bool stopTask)
+	{
+		const bool copyStatus = (m_status.isSuccess() && status && status->getState() == IStatus::STATE_ERRORS);
+		if (!copyStatus && (!stopTask || m_stop))
+			return;
+
+		MutexLockGuard guard(m_mutex, FB_FUNCTION);
+		if (m_status.isSuccess() && copyStatus)
+			m_status.save(status);
+		if (stopTask)
+			m_stop = true;
+	}
+
+	MemoryPool* m_pool;
+	Database* m_dbb;
+	Validation* m_validation;			// validation run the task works for
+	Mutex m_mutex;
+	HalfStaticArray<Item*, 8> m_items;
+	Array<USHORT> m_relations;			// relations to walk
+	Array<USHORT> m_skipped;			// relations not walked due to failed worker
+	FB_SIZE_T m_nextRelation;
+	StatusHolder m_status;
+	volatile bool m_stop;
+};
+
+
+bool ValidationTask::handler(WorkItem& _item)
+{
+	Item* item = reinterpret_cast<Item*>(&_item);
+
+	ThreadContextHolder tdbb(NULL);
+
+	if (!item->init(tdbb))
+	{
+		// Worker attachment is not available (for example, database is opened
+		// exclusively). Don't fail whole validation, relation will be walked
+		// by the validation run itself.
+
+		MutexLockGuard guard(m_mutex, FB_FUNCTION);
+		m_skipped.add(item->m_relId);
+		return false;
+	}
+
+	WorkerContextHolder wrkHolder(tdbb, FB_FUNCTION);
+
+	try
+	{
+		if (!item->m_pool)
+			item->m_pool = m_dbb->createPool();
+
+		Jrd::ContextPoolHolder context(tdbb, item->m_pool);
+
+		if (!item->m_validation)
+			item->m_validation = FB_NEW_POOL(*item->m_pool) Validation(tdbb, m_validation);
+
+		Validation* const validation = item->m_validation;
+		validation->vdr_tdbb = tdbb;
+
+		jrd_rel* relation = MET_lookup_relation_id(tdbb, item->m_relId, false);
+		if (relation)
+			validation->walk_relation_report(relation);
+
+		// Conditions of indices are bound to the worker attachment, release
+		// them while it is current
+
+		for (auto& info : validation->vdr_cond_idx)
+		{
+			delete info.m_recs;
+			delete info.m_condition;
+		}
+
+		validation->vdr_cond_idx.clear();
+
+		return !m_stop;
+	}
+	catch (const Exception& ex)
+	{
+		ex.stuffException(tdbb->tdbb_status_vector);
+	}
+
+	setError(tdbb->tdbb_status_vector, true);
+	return false;
+}
+
+
+bool ValidationTask::getWorkItem(WorkItem** pItem)
+{
+	Item* item = reinterpret_cast<Item*>(*pItem);
+
+	MutexLockGuard guard(m_mutex, FB_FUNCTION);
+
+	if (!item)
+	{
+		for (Item** p = m_items.begin(); p < m_items.end(); p++)
+		{
+			if (!(*p)->m_inuse)
+			{
+				(*p)->m_inuse = true;
+				*pItem = item = *p;
+				break;
+			}
+		}
+	}
+
+	if (!item)
+		return false;
+
+	if (m_stop || m_nextRelation >= m_relations.getCount())
+	{
+		item->m_inuse = false;
+		return false;
+	}
+
+	item->m_relId = m_relations[m_nextRelation++];
+	return true;
+}
+
+
 Validation::Validation(thread_db* tdbb, UtilSvc* uSvc)
 	: vdr_cond_idx(*tdbb->getDefaultPool()),
 	  vdr_used_bdbs(*tdbb->getDefaultPool())
@@ -872,6 +1151,7 @@ Validation::Validation(thread_db* tdbb, UtilSvc* uSvc)
 
 	vdr_service = uSvc;
 	vdr_lock_tout = -10;
+	vdr_parent = NULL;
 
 	if (uSvc) {
 		parse_args(tdbb);
@@ -879,9 +1159,39 @@ Validation::Validation(thread_db* tdbb, UtilSvc* uSvc)
 	output("Validation started\n\n");
 }
 
+Validation::Validation(thread_db* tdbb, Validation* parent)
+	: vdr_cond_idx(*tdbb->getDefaultPool()),
+	  vdr_used_bdbs(*tdbb->getDefaultPool())
+{
+	// Parallel worker inherits the settings of the validation run it works for
+
+	vdr_tdbb = tdbb;
+	vdr_max_page = 0;
+	vdr_flags = parent->vdr_flags;
+	vdr_errors = 0;
+	vdr_warns = 0;
+	vdr_fixed = 0;
+	vdr_max_transaction = parent->vdr_max_transaction;
+	vdr_rel_backversion_counter = 0;
+	vdr_backversion_pages = NULL;
+	vdr_rel_chain_counter = 0;
+	vdr_chain_pages = NULL;
+	vdr_rel_records = NULL;
+	vdr_idx_records = NULL;
+	vdr_page_bitmap = NULL;
+
+	for (USHORT i = 0; i < VAL_MAX_ERROR; i++)
+		vdr_err_counts[i] = 0;
+
+	vdr_service = parent->vdr_service;
+	vdr_lock_tout = parent->vdr_lock_tout;
+	vdr_parent = parent;
+}
+
 Validation::~Validation()
 {
-	output("Validation finished\n");
+	if (!vdr_parent)
+		output("Validation finished\n");
 }
 
 void Validation::parse_args(thread_db* tdbb)
@@ -976,6 +1286,9 @@ void Validation::output(const char* format, ...)
 	if (!vdr_service)
 		return;
 
+	Validation* const owner = vdr_parent ? vdr_parent : this;
+	MutexLockGuard guard(owner->vdr_mutex, FB_FUNCTION);
+
 	va_list params;
 	va_start(params, format);
 
@@ -1068,6 +1381,81 @@ bool Validation::run(thread_db* tdbb, USHORT flags)
 }
 
 
+bool Validation::index_excluded(const MetaName& index)
+{
+/**************************************
+ *
+ *	i n d e x _ e x c l u d e d
+ *
+ **************************************
+ *
+ * Functional description
+ *	Check index name against the include/exclude patterns.
+ *	Parallel workers share the patterns of their parent.
+ *
+ **************************************/
+	Validation* const owner = vdr_parent ? vdr_parent : this;
+	MutexLockGuard guard(owner->vdr_mutex, FB_FUNCTION);
+
+	if (owner->vdr_idx_incl)
+	{
+		if (!owner->vdr_idx_incl->matches(index.c_str(), index.length()))
+			return true;
+	}
+
+	if (owner->vdr_idx_excl)
+	{
+		if (owner->vdr_idx_excl->matches(index.c_str(), index.length()))
+			return true;
+	}
+
+	return false;
+}
+
+
+void Validation::merge(const Validation& worker)
+{
+/**************************************
+ *
+ *	m e r g e
+ *
+ **************************************
+ *
+ * Functional description
+ *	Account results of a parallel worker. Pages visited by the
+ *	worker are added to the page bitmap, the ones visited already
+ *	by somebody else are doubly allocated. SCN pages are visited by
+ *	every worker and are not accounted here.
+ *
+ **************************************/
+	vdr_errors += worker.vdr_errors;
+	vdr_warns += worker.vdr_warns;
+	vdr_fixed += worker.vdr_fixed;
+	vdr_max_page = MAX(vdr_max_page, worker.vdr_max_page);
+
+	for (USHORT i = 0; i < VAL_MAX_ERROR; i++)
+		vdr_err_counts[i] += worker.vdr_err_counts[i];
+
+	if ((vdr_flags & VDR_online) || !worker.vdr_page_bitmap)
+		return;
+
+	Database* dbb = vdr_tdbb->getDatabase();
+	const PageManager& pageMgr = dbb->dbb_page_manager;
+
+	PageBitmap::Accessor pages(worker.vdr_page_bitmap);
+
+	for (bool next = pages.getFirst(); next; next = pages.getNext())
+	{
+		const ULONG page_number = pages.current();
+
+		if (!PageBitmap::test(vdr_page_bitmap, page_number))
+			PBM_SET(vdr_tdbb->getDefaultPool(), &vdr_page_bitmap, page_number);
+		else if (page_number != PageSpace::getSCNPageNum(dbb, page_number / pageMgr.pagesPerSCN))
+			corrupt(VAL_PAG_DOUBLE_ALLOC, 0, page_number);
+	}
+}
+
+
 void Validation::cleanup()
 {
 	delete vdr_page_bitmap;
@@ -1433,6 +1821,7 @@ static void print_rhd(USHORT length, const rhd* header)
 		fprintf(stdout, "%s ", (header->rhd_flags & rhd_large) ? "LRG" : "   ");
 		fprintf(stdout, "%s ", (header->rhd_flags & rhd_damaged) ? "DAM" : "   ");
 		fprintf(stdout, "%s ", (header->rhd_flags & rhd_not_packed) ? "NPK" : "   ");
+		fprintf(stdout, "%s ", (header->rhd_flags & rhd_lz_packed) ? "LZP" : "   ");
 		fprintf(stdout, "\n");
 	}
 }
@@ -1628,6 +2017,11 @@ void Validation::walk_database()
 		walk_generators();
 	}
 
+	// Relations may be walked in parallel, by worker attachments
+
+	const int workers = attachment->att_parallel_workers;
+	Array<USHORT> relations(*vdr_tdbb->getDefaultPool());
+
 	vec<jrd_rel*>* vector;
 	for (USHORT i = 0; (vector = attachment->att_relations) && i < vector->count(); i++)
 	{
@@ -1659,26 +2053,18 @@ void Validation::walk_database()
 					continue;
 			}
 
-			// We can't realiable track double allocated page's when validating online.
-			// All we can check is that page is not double allocated at the same relation.
-			if (vdr_flags & VDR_online)
-				vdr_page_bitmap->clear();
-
-			string relName;
-			relName.printf("Relation %d (%s)", relation->rel_id, relation->rel_name.c_str());
-			output("%s\n", relName.c_str());
-
-			int errs = vdr_errors;
-			walk_relation(relation);
-			errs = vdr_errors - errs;
-
-			if (!errs)
-				output("%s is ok\n\n", relName.c_str());
+			if (workers > 1)
+				relations.add(relation->rel_id);
 			else
-				output("%s : %d ERRORS found\n\n", relName.c_str(), errs);
+				walk_relation_report(relation);
 		}
 	}
 
+	if (relations.getCount() > 1)
+		walk_parallel(relations, workers);
+	else if (relations.hasData())
+		walk_relation_report(MET_lookup_relation_id(vdr_tdbb, relations[0], false));
+
 	if (!(vdr_flags & VDR_online)) {
 		release_page(&window);
 	}
@@ -1738,6 +2124,9 @@ Validation::RTN Validation::walk_data_page(jrd_rel* relation, ULONG page_number,
 	if (dp_flags & dpg_secondary)
 		pp_bits |= ppg_dp_secondary;
 
+	if (dp_flags & dpg_all_visible)
+		pp_bits |= ppg_dp_all_visible;
+
 	if (page->dpg_count == 0)
 		pp_bits |= ppg_dp_empty;
 
@@ -1979,6 +2368,9 @@ Validation::RTN Validation::walk_index(jrd_rel* relation, index_root_page* root_
 	if (!page_number)
 		return rtn_ok;
 
+	if (root_page->irt_rpt[id].irt_flags & irt_block_range)
+		return walk_ranges(relation, page_number, id);
+
 	const bool unique = (root_page->irt_rpt[id].irt_flags & (irt_unique | idx_primary));
 	const bool descending = (root_page->irt_rpt[id].irt_flags & irt_descending);
 	const bool condition = (root_page->irt_rpt[id].irt_flags & irt_condition);
@@ -2405,6 +2797,42 @@ Validation::RTN Validation::walk_index(jrd_rel* relation, index_root_page* root_
 	return rtn_ok;
 }
 
+void Validation::walk_parallel(const Array<USHORT>& relations, int workers)
+{
+/**************************************
+ *
+ *	w a l k _ p a r a l l e l
+ *
+ **************************************
+ *
+ * Functional description
+ *	Walk given relations using parallel workers.
+ *
+ **************************************/
+	Database* dbb = vdr_tdbb->getDatabase();
+
+	ValidationTask task(vdr_tdbb, this, relations, workers);
+	{
+		EngineCheckout cout(vdr_tdbb, FB_FUNCTION);
+
+		Coordinator coord(dbb->dbb_permanent);
+		coord.runSync(&task);
+	}
+
+	const Array<USHORT>& skipped = task.finish();
+
+	FbLocalStatus status;
+	if (!task.getResult(&status))
+		status.raise();
+
+	for (const USHORT* relId = skipped.begin(); relId < skipped.end(); relId++)
+	{
+		jrd_rel* relation = MET_lookup_relation_id(vdr_tdbb, *relId, false);
+		if (relation)
+			walk_relation_report(relation);
+	}
+}
+
 void Validation::walk_pip()
 {
 /**************************************
@@ -2694,6 +3122,72 @@ Validation::RTN Validation::walk_pointer_page(jrd_rel* relation, ULONG sequence)
 }
 
 
+Validation::RTN Validation::walk_ranges(jrd_rel* relation, ULONG page_number, USHORT id)
+{
+/**************************************
+ *
+ *	w a l k _ r a n g e s
+ *
+ **************************************
+ *
+ * Functional description
+ *	Walk the directory and the summary pages of a block
+ *	range index. The summaries are not compared with the
+ *	records as they are allowed to be wider than the data.
+ *
+ **************************************/
+	Database* dbb = vdr_tdbb->getDatabase();
+
+	WIN window(DB_PAGE_SPACE, -1);
+	range_page* page = nullptr;
+	fetch_page(true, page_number, pag_range, &window, &page);
+
+	if (page->rng_relation != relation->rel_id || page->rng_id != id ||
+		!(page->rng_header.pag_flags & rng_directory))
+	{
+		corrupt(VAL_INDEX_PAGE_CORRUPT, relation, id + 1, page_number, 0, 0, __FILE__, __LINE__);
+		release_page(&window);
+		return rtn_corrupt;
+	}
+
+	const USHORT keyLength = page->rng_key_length;
+	const ULONG directorySize = (dbb->dbb_page_size - RNG_SIZE) / sizeof(ULONG);
+
+	if (page->rng_count > directorySize ||
+		rangeSummaryLength(keyLength) > dbb->dbb_page_size - RNG_SIZE)
+	{
+		corrupt(VAL_INDEX_PAGE_CORRUPT, relation, id + 1, page_number, 0, 0, __FILE__, __LINE__);
+		release_page(&window);
+		return rtn_corrupt;
+	}
+
+	HalfStaticArray<ULONG, 64> pages;
+	pages.assign(page->rng_data, page->rng_count);
+	release_page(&window);
+
+	for (ULONG sequence = 0; sequence < pages.getCount(); sequence++)
+	{
+		const ULONG number = pages[sequence];
+
+		if (!number)
+			continue;
+
+		fetch_page(true, number, pag_range, &window, &page);
+
+		if (page->rng_relation != relation->rel_id || page->rng_id != id ||
+			page->rng_sequence != sequence || page->rng_key_length != keyLength ||
+			(page->rng_header.pag_flags & rng_directory))
+		{
+			corrupt(VAL_INDEX_PAGE_CORRUPT, relation, id + 1, number, 0, 0, __FILE__, __LINE__);
+		}
+
+		release_page(&window);
+	}
+
+	return rtn_ok;
+}
+
+
 Validation::RTN Validation::walk_record(jrd_rel* relation, const rhd* header, USHORT length,
 	RecordNumber number, bool delta_flag)
 {
@@ -2773,9 +3267,9 @@ Validation::RTN Validation::walk_record(jrd_rel* relation, const rhd* header, US
 	const auto format = MET_format(vdr_tdbb, relation, header->rhd_format);
 	auto remainingLength = format->fmt_length;
 
-	auto calculateLength = [remainingLength](ULONG length, const UCHAR* data, bool notPacked)
+	auto calculateLength = [remainingLength](ULONG length, const UCHAR* data, USHORT flags)
 	{
-		if (notPacked)
+		if (flags & rhd_not_packed)
 		{
 			if (length > remainingLength)
 			{
@@ -2791,11 +3285,10 @@ Validation::RTN Validation::walk_record(jrd_rel* relation, const rhd* header, US
 			return length;
 		}
 
-		return Compressor::getUnpackedLength(length, data);
+		return Compressor::getUnpackedLength(length, data, (flags & rhd_lz_packed) != 0);
 	};
 
-	bool notPacked = (fragment->rhdf_flags & rhd_not_packed) != 0;
-	remainingLength -= calculateLength(length, p, notPacked);
+	remainingLength -= calculateLength(length, p, fragment->rhdf_flags);
 
 	// Next, chase down fragments, if any
 
@@ -2847,8 +3340,7 @@ Validation::RTN Validation::walk_record(jrd_rel* relation, const rhd* header, US
 			length -= RHD_SIZE;
 		}
 
-		notPacked = (fragment->rhdf_flags & rhd_not_packed) != 0;
-		remainingLength -= calculateLength(length, p, notPacked);
+		remainingLength -= calculateLength(length, p, fragment->rhdf_flags);
 
 		page_number = fragment->rhdf_f_page;
 		line_number = fragment->rhdf_f_line;
@@ -2893,6 +3385,12 @@ void restoreFlags(UCHAR* byte, UCHAR flags, bool empty)
 	else
 		*byte &= ~bit;
 
+	bit = PPG_DP_BIT_MASK(slot, ppg_dp_all_visible);
+	if (flags & dpg_all_visible)
+		*byte |= bit;
+	else
+		*byte &= ~bit;
+
 	bit = PPG_DP_BIT_MASK(slot, ppg_dp_empty);
 	if (empty)
 		*byte |= bit;
@@ -3188,6 +3686,39 @@ Validation::RTN Validation::walk_relation(jrd_rel* relation)
 }
 
 
+void Validation::walk_relation_report(jrd_rel* relation)
+{
+/**************************************
+ *
+ *	w a l k _ r e l a t i o n _ r e p o r t
+ *
+ **************************************
+ *
+ * Functional description
+ *	Walk relation and report its state.
+ *
+ **************************************/
+
+	// We can't realiable track double allocated page's when validating online.
+	// All we can check is that page is not double allocated at the same relation.
+	if ((vdr_flags & VDR_online) && vdr_page_bitmap)
+		vdr_page_bitmap->clear();
+
+	string relName;
+	relName.printf("Relation %d (%s)", relation->rel_id, relation->rel_name.c_str());
+	output("%s\n", relName.c_str());
+
+	int errs = vdr_errors;
+	walk_relation(relation);
+	errs = vdr_errors - errs;
+
+	if (!errs)
+		output("%s is ok\n\n", relName.c_str());
+	else
+		output("%s : %d ERRORS found\n\n", relName.c_str(), errs);
+}
+
+
 Validation::RTN Validation::walk_root(jrd_rel* relation, bool getInfo)
 {
 /**************************************
@@ -3223,17 +3754,8 @@ Validation::RTN Validation::walk_root(jrd_rel* relation, bool getInfo)
 		MET_lookup_index(vdr_tdbb, index, relation->rel_name, i + 1);
 		fetch_page(false, relPages->rel_index_root, pag_root, &window, &page);
 
-		if (vdr_idx_incl)
-		{
-			if (!vdr_idx_incl->matches(index.c_str(), index.length()))
-				continue;
-		}
-
-		if (vdr_idx_excl)
-		{
-			if (vdr_idx_excl->matches(index.c_str(), index.length()))
-				continue;
-		}
+		if (index_excluded(index))
+			continue;
 
 		if (getInfo)
 		{
@@ -28,6 +28,7 @@
 #include "fb_types.h"
 
 #include "../common/classes/array.h"
+#include "../common/classes/locks.h"
 #include "../common/SimilarToRegex.h"
 #include "../jrd/ods.h"
 #include "../jrd/cch.h"
@@ -47,12 +48,15 @@ class Attachment;
 class Database;
 class jrd_rel;
 class thread_db;
+class ValidationTask;
 
 
 // Validation/garbage collection/repair control block
 
 class Validation
 {
+	friend class ValidationTask;
+
 public:
 	// vdr_flags
 
@@ -167,6 +171,8 @@ private:
 	Firebird::AutoPtr<Firebird::SimilarToRegex> vdr_idx_incl;
 	Firebird::AutoPtr<Firebird::SimilarToRegex> vdr_idx_excl;
 	int vdr_lock_tout;
+	Validation* vdr_parent;					// validation run that started this parallel worker
+	Firebird::Mutex vdr_mutex;				// serializes output of parallel workers
 	void checkDPinPP(jrd_rel *relation, ULONG page_number);
 	void checkDPinPIP(jrd_rel *relation, ULONG page_number);
 
@@ -199,6 +205,8 @@ private:
 
 	UsedBdbs vdr_used_bdbs;
 
+	Validation(thread_db*, Validation* parent);
+
 	void cleanup();
 	RTN corrupt(int, const jrd_rel*, ...);
 	FETCH_CODE fetch_page(bool mark, ULONG, USHORT, WIN*, void*);
@@ -207,6 +215,8 @@ private:
 
 	void parse_args(thread_db*);
 	void output(const char*, ...);
+	bool index_excluded(const MetaName&);
+	void merge(const Validation&);
 
 	RTN walk_blob(jrd_rel*, const Ods::blh*, USHORT, RecordNumber);
 	RTN walk_chain(jrd_rel*, const Ods::rhd*, RecordNumber);
@@ -215,9 +225,12 @@ private:
 	void walk_generators();
 	RTN walk_index(jrd_rel*, Ods::index_root_page*, USHORT);
 	void walk_pip();
+	void walk_parallel(const Firebird::Array<USHORT>&, int);
 	RTN walk_pointer_page(jrd_rel*, ULONG);
+	RTN walk_ranges(jrd_rel*, ULONG, USHORT);
 	RTN walk_record(jrd_rel*, const Ods::rhd*, USHORT, RecordNumber, bool);
 	RTN walk_relation(jrd_rel*);
+	void walk_relation_report(jrd_rel*);
 	RTN walk_root(jrd_rel*, bool);
 	RTN walk_scns();
 	RTN walk_tip(TraNumber);
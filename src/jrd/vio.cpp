@@ -597,7 +597,8 @@ namespace
 			return output;
 		}
 
-		return Compressor::unpack(rpb->rpb_length, rpb->rpb_address, outLength, output);
+		return Compressor::unpack(rpb->rpb_length, rpb->rpb_address, outLength, output,
+								  (rpb->rpb_flags & rpb_lz_packed) != 0);
 	}
 };
 
@@ -2725,9 +2726,41 @@ void VIO_intermediate_gc(thread_db* tdbb, record_param* rpb, jrd_tra* transactio
 		precedence_stack.push(PageNumber(relPages->rel_pg_space_id, staying_chain_rpb.rpb_page));
 	}
 
+	// Since ODS 14.1 index-only scans trust keys of all-visible pages, so indices
+	// are garbage-collected before the versions are cut off the record. Then an
+	// interrupted garbage collection never leaves index keys without versions.
+	const bool indexFirst = (dbb->getEncodedOdsVersion() >= ODS_14_1);
+
 	// Read head version with write lock and check if it is still the same version
 	record_param temp_rpb = *rpb;
 
+	if (indexFirst)
+	{
+		if (!DPM_get(tdbb, &temp_rpb, LCK_read))
+		{
+			delete_version_chain(tdbb, &staying_chain_rpb, true);
+			clearRecordStack(staying);
+			clearRecordStack(going);
+			return;
+		}
+
+		const bool changed = (temp_rpb.rpb_transaction_nr != rpb->rpb_transaction_nr ||
+			temp_rpb.rpb_b_line != rpb->rpb_b_line || temp_rpb.rpb_b_page != rpb->rpb_b_page);
+
+		CCH_RELEASE(tdbb, &temp_rpb.getWindow(tdbb));
+
+		if (changed)
+		{
+			delete_version_chain(tdbb, &staying_chain_rpb, true);
+			clearRecordStack(staying);
+			clearRecordStack(going);
+			return;
+		}
+
+		IDX_garbage_collect(tdbb, rpb, going, staying);
+		temp_rpb = *rpb;
+	}
+
 	// If record no longer exists - return
 	if (!DPM_get(tdbb, &temp_rpb, LCK_write))
 	{
@@ -2771,7 +2804,9 @@ void VIO_intermediate_gc(thread_db* tdbb, record_param* rpb, jrd_tra* transactio
 
 	// Garbage-collect blobs and indices
 	BLB_garbage_collect(tdbb, going, staying, rpb->rpb_page, rpb->rpb_relation);
-	IDX_garbage_collect(tdbb, rpb, going, staying);
+
+	if (!indexFirst)
+		IDX_garbage_collect(tdbb, rpb, going, staying);
 
 	// Free memory for record versions we fetched during list_staying
 	clearRecordStack(staying);
@@ -5148,6 +5183,36 @@ static void expunge(thread_db* tdbb, record_param* rpb, const jrd_tra* transacti
 		return;
 	}
 
+	// Since ODS 14.1 get rid of index keys of the old versions while the record
+	// still holds them, so an interrupted expunge never leaves keys without versions.
+
+	if (rpb->rpb_b_page && tdbb->getDatabase()->getEncodedOdsVersion() >= ODS_14_1)
+	{
+		const record_param org_rpb = *rpb;
+		CCH_RELEASE(tdbb, &rpb->getWindow(tdbb));
+
+		record_param temp = org_rpb;
+		RecordStack going, empty_staying;
+		list_staying(tdbb, &temp, going, LS_NO_RESTART);
+
+		if (!going.hasData())
+			return;
+
+		IDX_garbage_collect(tdbb, rpb, going, empty_staying);
+		clearRecordStack(going);
+
+		if (!DPM_get(tdbb, rpb, LCK_write))
+			return;
+
+		if (rpb->rpb_transaction_nr != org_rpb.rpb_transaction_nr ||
+			rpb->rpb_b_page != org_rpb.rpb_b_page || rpb->rpb_b_line != org_rpb.rpb_b_line ||
+			!(rpb->rpb_flags & rpb_deleted))
+		{
+			CCH_RELEASE(tdbb, &rpb->getWindow(tdbb));
+			return;
+		}
+	}
+
 	delete_record(tdbb, rpb, prior_page, NULL);
 
 	// If there aren't any old versions, don't worry about garbage collection.
@@ -5181,6 +5246,8 @@ static void garbage_collect(thread_db* tdbb, record_param* rpb, ULONG prior_page
  *	2) just had its back pointers set to zero
  *	Therefor we can do a fetch on the back pointers we've got
  *	because we have the last existing copy of them.
+ *	Since ODS 14.1 index keys of the chain are expected to be
+ *	removed by the caller before the chain was cut off the record.
  *
  **************************************/
 
@@ -5228,7 +5295,9 @@ static void garbage_collect(thread_db* tdbb, record_param* rpb, ULONG prior_page
 		JRD_reschedule(tdbb);
 	}
 
-	IDX_garbage_collect(tdbb, rpb, going, staying);
+	if (tdbb->getDatabase()->getEncodedOdsVersion() < ODS_14_1)
+		IDX_garbage_collect(tdbb, rpb, going, staying);
+
 	BLB_garbage_collect(tdbb, going, staying, prior_page, rpb->rpb_relation);
 
 	clearRecordStack(going);
@@ -5701,8 +5770,8 @@ static void list_staying_fast(thread_db* tdbb, record_param* rpb, RecordStack& s
 	fb_assert(temp.rpb_b_page == rpb->rpb_b_page);
 	fb_assert(temp.rpb_b_line == rpb->rpb_b_line);
 
-	fb_assert((temp.rpb_flags & ~(rpb_incomplete | rpb_not_packed)) ==
-			  (rpb->rpb_flags & ~(rpb_incomplete | rpb_not_packed)));
+	fb_assert((temp.rpb_flags & ~(rpb_incomplete | rpb_not_packed | rpb_lz_packed)) ==
+			  (rpb->rpb_flags & ~(rpb_incomplete | rpb_not_packed | rpb_lz_packed)));
 
 	Record* backout_rec = NULL;
 	RuntimeStatistics::Accumulator backversions(tdbb, rpb->rpb_relation,
@@ -6525,6 +6594,28 @@ static void purge(thread_db* tdbb, record_param* rpb)
 	temp.rpb_prior = rpb->rpb_prior;
 	rpb->rpb_record = temp.rpb_record;
 
+	RecordStack staying;
+	staying.push(record);
+
+	// Since ODS 14.1 get rid of index keys of the old versions before they are
+	// cut off the record, so an interrupted purge never leaves keys without versions.
+
+	if (tdbb->getDatabase()->getEncodedOdsVersion() >= ODS_14_1)
+	{
+		record_param list_rpb = temp;
+		list_rpb.rpb_record = NULL;
+		list_rpb.rpb_prior = NULL;
+
+		RecordStack going;
+		list_staying(tdbb, &list_rpb, going, LS_NO_RESTART);
+
+		if (!going.hasData())
+			return; // true;
+
+		IDX_garbage_collect(tdbb, rpb, going, staying);
+		clearRecordStack(going);
+	}
+
 	if (!DPM_get(tdbb, rpb, LCK_write))
 	{
 		// purge
@@ -6550,8 +6641,6 @@ static void purge(thread_db* tdbb, record_param* rpb)
 	DPM_rewrite_header(tdbb, rpb);
 	CCH_RELEASE(tdbb, &rpb->getWindow(tdbb));
 
-	RecordStack staying;
-	staying.push(record);
 	garbage_collect(tdbb, &temp, rpb->rpb_page, staying);
 
 	tdbb->bumpRelStats(RuntimeStatistics::RECORD_PURGES, relation->rel_id);
@@ -5089,8 +5089,8 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 	if ((!statement->rsr_flags.test(Rsr::STREAM_END | Rsr::STREAM_ERR) &&
 		!statement->rsr_message->msg_address && !statement->rsr_rows_pending) ||
 		(	// Low in inventory
-			(statement->rsr_rows_pending <= statement->rsr_reorder_level) &&
-			(statement->rsr_msgs_waiting <= statement->rsr_reorder_level) &&
+			(statement->rsr_rows_pending <= statement->rsr_reorder_level + statement->rsr_fetch_ahead) &&
+			(statement->rsr_msgs_waiting <= statement->rsr_reorder_level + statement->rsr_fetch_ahead) &&
 			// Pipelining causes both server & client to
 			// write at the same time. In XNET, writes
 			// block for the other end to read -  and so when both
@@ -5125,9 +5125,12 @@ bool ResultSet::fetch(CheckStatusWrapper* status, void* buffer, P_FETCH operatio
 					port, 0, op_fetch_response, statement->rsr_select_format);
 			}
 
-			// Reorder data when the local buffer is half empty
+			// Reorder data when the local buffer is half empty. If more batches
+			// are allowed to be requested ahead, reorder them in advance.
 
 			statement->rsr_reorder_level = sqldata->p_sqldata_messages / 2;
+			statement->rsr_fetch_ahead = (operation == fetch_next || operation == fetch_prior) ?
+				(port->getPortConfig()->getRemoteFetchAhead() - 1) * sqldata->p_sqldata_messages : 0;
 #ifdef DEBUG
 			fprintf(stdout, "Recalculating Rows Pending in REM_fetch=%lu\n",
 					   statement->rsr_rows_pending);
@@ -8083,11 +8086,9 @@ static void clear_stmt_que(rem_port* port, Rsr* statement)
  * Functional description
  *
  * Receive and handle all queued packets for a completely fetched statement.
- * There must be no more than one such packet.
+ * There may be a few of them if batches are requested ahead.
  *
  **************************************/
-	fb_assert(statement->rsr_batch_count <= 1);
-
 	while (statement->rsr_batch_count)
 		receive_queued_packet(port, statement->rsr_id);
 
@@ -8160,6 +8161,10 @@ static void batch_dsql_fetch(rem_port*	port,
 
 	UsePreallocatedBuffer guardBlobInfo(p_blob->p_blob_info, sizeof(blobInfo), blobInfo);
 
+	// If the stream has already been ended by EOF or error, this batch was requested
+	// ahead and its contents are of no use, so they're just swallowed.
+	const bool stale = statement->rsr_flags.test(Rsr::STREAM_END | Rsr::STREAM_ERR);
+
 	statement->rsr_flags.set(Rsr::FETCHED);
 	while (true)
 	{
@@ -8182,6 +8187,8 @@ static void batch_dsql_fetch(rem_port*	port,
 			message->msg_next = new_msg;
 		}
 
+		RMessage* const buffer = statement->rsr_buffer;
+
 		try {
 			receive_packet_noqueue(port, packet);
 		}
@@ -8208,23 +8215,35 @@ static void batch_dsql_fetch(rem_port*	port,
 
 		if (packet->p_operation != op_fetch_response)
 		{
-			statement->rsr_flags.set(Rsr::STREAM_ERR);
-
-			try
+			if (!stale)
 			{
-				REMOTE_check_response(&status, rdb, packet);
-				statement->saveException(&status, false);
-			}
-			catch (const Exception& ex)
-			{
-				// Queue errors within the batched request
-				statement->saveException(ex, false);
+				statement->rsr_flags.set(Rsr::STREAM_ERR);
+
+				try
+				{
+					REMOTE_check_response(&status, rdb, packet);
+					statement->saveException(&status, false);
+				}
+				catch (const Exception& ex)
+				{
+					// Queue errors within the batched request
+					statement->saveException(ex, false);
+				}
 			}
 
 			statement->rsr_rows_pending = 0;
 			--statement->rsr_batch_count;
 			dequeue_receive(port);
 
+			// clear batches requested after the failed one, if present
+			if (!stale)
+			{
+				try
+				{
+					clear_stmt_que(port, statement);
+				}
+				catch (const Exception&) { }
+			}
 			break;
 		}
 
@@ -8232,7 +8251,7 @@ static void batch_dsql_fetch(rem_port*	port,
 
 		if (packet->p_sqldata.p_sqldata_status || !packet->p_sqldata.p_sqldata_messages)
 		{
-			if (packet->p_sqldata.p_sqldata_status == 100)
+			if (packet->p_sqldata.p_sqldata_status == 100 && !stale)
 			{
 				const auto operation = statement->rsr_fetch_operation;
 				const auto position = statement->rsr_fetch_position;
@@ -8259,7 +8278,7 @@ static void batch_dsql_fetch(rem_port*	port,
 			dequeue_receive(port);
 
 			// clear next queued batch(es) if present
-			if (packet->p_sqldata.p_sqldata_status == 100)
+			if (packet->p_sqldata.p_sqldata_status == 100 && !stale)
 			{
 				try
 				{
@@ -8270,6 +8289,14 @@ static void batch_dsql_fetch(rem_port*	port,
 			break;
 		}
 
+		if (stale)
+		{
+			// Release the buffer just filled
+			buffer->msg_address = NULL;
+			statement->rsr_buffer = buffer;
+			continue;
+		}
+
 		statement->rsr_msgs_waiting++;
 		statement->rsr_rows_pending--;
 
@@ -8878,9 +8905,9 @@ static void authReceiveResponse(bool havePacket, ClntAuthBlock& cBlock, rem_port
 			HANDSHAKE_DEBUG(fprintf(stderr, "Cli: authReceiveResponse: cond_accept d=%d n=%d '%.*s' 0x%x\n",
 				d->cstr_length, n->cstr_length,
 				n->cstr_length, n->cstr_address, n->cstr_address ? n->cstr_address[0] : 0));
-			if (packet->p_acpd.p_acpt_type & pflag_compress)
+			if (packet->p_acpd.p_acpt_type & pflag_compress_MASK)
 			{
-				port->initCompression();
+				port->initCompression(packet->p_acpd.p_acpt_type);
 				port->port_flags |= PORT_compressed;
 			}
 			packet->p_acpd.p_acpt_type &= ptype_MASK;
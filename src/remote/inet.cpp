@@ -95,6 +95,11 @@
 #include <sys/select.h>
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#define USE_EPOLL
+#endif
+
 #endif // !WIN_NT
 
 constexpr int INET_RETRY_CALL = 5;
@@ -232,6 +237,8 @@ constexpr ULONG DEF_MAX_DATA	= 8192;
 
 constexpr int SELECT_TIMEOUT	= 60;		// Dispatch thread select timeout (sec)
 
+static GlobalPtr<Mutex> port_mutex;
+
 class Select
 {
 #ifdef HAVE_POLL
@@ -414,6 +421,18 @@ public:
 #endif // HAVE_POLL
 	}
 
+	void set(const rem_port* port)
+	{
+		set(port->port_handle);
+	}
+
+	// Sockets of the multiclient listener are collected by set() before each wait
+	void add(rem_port* /*port*/)
+	{ }
+
+	void remove(rem_port* /*port*/)
+	{ }
+
 	void clear()
 	{
 		slct_count = 0;
@@ -501,6 +520,339 @@ private:
 #endif
 };
 
+#ifdef USE_EPOLL
+// Multiclient listener backend. A socket is added to the epoll set once its port may
+// receive data (listening port, accepted connection, accepted auxiliary connection)
+// and removed from it on disconnect, so neither a wait nor looking for ready ports
+// after it walks the connected ports - the cost depends on the active ports only.
+class EpollSelect
+{
+private:
+	static constexpr int MAX_EVENTS = 512;
+
+	struct Registration
+	{
+		SOCKET handle;
+		rem_port* port;		// referenced while registered
+	};
+
+	class RegistrationToFD
+	{
+	public:
+		static SOCKET generate(const Registration& r) { return r.handle; }
+	};
+
+	struct Candidate
+	{
+		rem_port* port;		// referenced while candidate
+		bool ready;			// reported by the last wait
+	};
+
+public:
+	typedef Select::HandleState HandleState;
+
+	explicit EpollSelect(MemoryPool& pool)
+		: slct_time(0), slct_count(0), slct_epoll(-1), slct_next(0),
+		  slct_registered(pool), slct_failed(pool), slct_candidates(pool)
+	{ }
+
+	~EpollSelect()
+	{
+		clear();
+
+		for (auto& reg : slct_registered)
+			releaseRef(reg.port);
+
+		for (auto port : slct_failed)
+			releaseRef(port);
+
+		if (slct_epoll >= 0)
+			::close(slct_epoll);
+	}
+
+	void checkStart(RemPortPtr& /*port*/)
+	{
+		slct_next = 0;
+#ifdef WIRE_COMPRESS_SUPPORT
+		slct_zport = nullptr;
+#endif
+	}
+
+	// get port to check for readiness
+	// assume port_mutex is locked
+	HandleState checkNext(RemPortPtr& port)
+	{
+#ifdef WIRE_COMPRESS_SUPPORT
+		if (slct_zport)
+		{
+			if (slct_zport->port_z_data &&
+				(slct_zport->port_state != rem_port::DISCONNECTED))
+			{
+				port = slct_zport;
+				slct_zport = nullptr;	// Will be set again by select_multi() if needed
+				return Select::SEL_READY;
+			}
+
+			slct_zport = nullptr;
+		}
+#endif
+
+		while (slct_next < slct_candidates.getCount())
+		{
+			Candidate& candidate = slct_candidates[slct_next++];
+			port = candidate.port;
+
+			if (port->port_state == rem_port::DISCONNECTED)
+				continue;
+
+#ifdef WIRE_COMPRESS_SUPPORT
+			if (port->port_z_data)
+				return Select::SEL_READY;
+#endif
+			if (port->port_handle < 0)
+				return port->port_flags & PORT_disconnect ? Select::SEL_DISCONNECTED : Select::SEL_BAD;
+
+			if (candidate.ready)
+			{
+				candidate.ready = false;
+				return Select::SEL_READY;
+			}
+
+			return Select::SEL_NO_DATA;
+		}
+
+		port = nullptr;
+		return Select::SEL_NO_DATA;
+	}
+
+	void setZDataPort(RemPortPtr& port)
+	{
+#ifdef WIRE_COMPRESS_SUPPORT
+		slct_zport = port;
+#endif
+	}
+
+	// Return the port to the caller after the next wait, ready or not
+	// assume port_mutex is locked
+	void check(rem_port* port)
+	{
+		addCandidate(port, false);
+	}
+
+	// Start waiting for the port's socket until remove() is called
+	// assume port_mutex is locked
+	void add(rem_port* port)
+	{
+		const SOCKET handle = port->port_handle;
+
+		if (handle < 0)
+			return;
+
+		FB_SIZE_T pos;
+		if (slct_registered.find(handle, pos))
+		{
+			Registration& reg = slct_registered[pos];
+			if (reg.port == port)
+				return;
+
+			// The descriptor was closed and now belongs to another port
+			releaseRef(reg.port);
+			slct_registered.remove(pos);
+		}
+
+		if (slct_epoll < 0)
+		{
+			slct_epoll = epoll_create1(EPOLL_CLOEXEC);
+			if (slct_epoll < 0)
+			{
+				gds__log("INET/select: epoll_create failed, errno = %d", INET_ERRNO);
+				fail(port);
+				return;
+			}
+		}
+
+		epoll_event event {};
+		event.events = EPOLLIN;
+		event.data.fd = handle;
+
+		if (epoll_ctl(slct_epoll, EPOLL_CTL_ADD, handle, &event) != 0 &&
+			(INET_ERRNO != EEXIST || epoll_ctl(slct_epoll, EPOLL_CTL_MOD, handle, &event) != 0))
+		{
+			gds__log("INET/select: epoll_ctl failed for socket %" HANDLEFORMAT ", errno = %d",
+				handle, INET_ERRNO);
+			fail(port);
+			return;
+		}
+
+		port->addRef();
+
+		Registration reg;
+		reg.handle = handle;
+		reg.port = port;
+		slct_registered.add(reg);
+	}
+
+	// Stop waiting for the port's socket, must be called before it's closed
+	// assume port_mutex is locked
+	void remove(rem_port* port)
+	{
+		FB_SIZE_T pos;
+		if (port->port_handle >= 0 && slct_registered.find(port->port_handle, pos) &&
+			slct_registered[pos].port == port)
+		{
+			unregister(pos);
+		}
+	}
+
+	// assume port_mutex is locked
+	bool hasPorts() const
+	{
+		return slct_registered.hasData() || slct_failed.hasData() || slct_candidates.hasData();
+	}
+
+	void clear()
+	{
+		slct_count = 0;
+
+		for (auto& candidate : slct_candidates)
+			releaseRef(candidate.port);
+
+		slct_candidates.clear();
+		slct_next = 0;
+#ifdef WIRE_COMPRESS_SUPPORT
+		slct_zport = nullptr;
+#endif
+	}
+
+	void select(timeval* timeout)
+	{
+		{ // port_mutex scope
+			MutexLockGuard guard(port_mutex, FB_FUNCTION);
+
+			// Ports failed to be registered are returned to the caller at once,
+			// their sockets are shut down so the receive breaks the connection
+			for (auto port : slct_failed)
+			{
+				Candidate candidate;
+				candidate.port = port;
+				candidate.ready = true;
+				slct_candidates.add(candidate);
+			}
+
+			slct_failed.clear();
+
+			if (slct_registered.isEmpty())
+			{
+				if (slct_candidates.isEmpty())
+				{
+					errno = NOTASOCKET;
+					slct_count = -1;
+				}
+				else
+					slct_count = slct_candidates.getCount();
+
+				return;
+			}
+		}
+
+		const int milliseconds = slct_candidates.hasData() ? 0 :
+			timeout ? timeout->tv_sec * 1000 + timeout->tv_usec / 1000 : -1;
+		epoll_event* const events = slct_events.getBuffer(MAX_EVENTS);
+		const int count = epoll_wait(slct_epoll, events, MAX_EVENTS, milliseconds);
+
+		if (count < 0)
+		{
+			slct_count = -1;
+			return;
+		}
+
+		MutexLockGuard guard(port_mutex, FB_FUNCTION);
+
+		for (int i = 0; i < count; ++i)
+		{
+			// The descriptors of disconnected ports are closed by select_wait()
+			// only, so a reported descriptor can't belong to another port yet
+			FB_SIZE_T pos;
+			if (!slct_registered.find(events[i].data.fd, pos))
+				continue;
+
+			rem_port* const port = slct_registered[pos].port;
+
+			// Broken port is not waited for any more, else its hangup would
+			// be reported by every following wait
+			if (port->port_state != rem_port::PENDING)
+			{
+				unregister(pos);
+				continue;
+			}
+
+			// Hangup and error are reported to the caller as readiness,
+			// the following receive detects the broken connection
+			addCandidate(port, true);
+		}
+
+		slct_count = slct_candidates.getCount();
+	}
+
+	int getCount() noexcept
+	{
+		return slct_count;
+	}
+
+	time_t	slct_time;
+
+private:
+	// Port references may be released by RefPtr only
+	static void releaseRef(rem_port* port)
+	{
+		const RemPortPtr ref(REF_NO_INCR, port);
+	}
+
+	void addCandidate(rem_port* port, bool ready)
+	{
+		port->addRef();
+
+		Candidate candidate;
+		candidate.port = port;
+		candidate.ready = ready;
+		slct_candidates.add(candidate);
+	}
+
+	// The port's socket can't be waited for, make the receive break the connection
+	void fail(rem_port* port)
+	{
+		shutdown(port->port_handle, 2);
+		port->addRef();
+		slct_failed.add(port);
+	}
+
+	void unregister(FB_SIZE_T pos)
+	{
+		Registration& reg = slct_registered[pos];
+
+		epoll_event event {};
+		epoll_ctl(slct_epoll, EPOLL_CTL_DEL, reg.handle, &event);
+		releaseRef(reg.port);
+		slct_registered.remove(pos);
+	}
+
+	int		slct_count;
+	int		slct_epoll;
+	FB_SIZE_T slct_next;		// next candidate to check for readiness
+	SortedArray<Registration, InlineStorage<Registration, 8>, SOCKET, RegistrationToFD> slct_registered;
+	HalfStaticArray<rem_port*, 8> slct_failed;			// ports failed to be registered
+	HalfStaticArray<Candidate, 64> slct_candidates;		// ready ports and ports needing attention
+	HalfStaticArray<epoll_event, 1> slct_events;
+#ifdef WIRE_COMPRESS_SUPPORT
+	RemPortPtr slct_zport;	// port with some compressed data remaining in the buffer
+#endif
+};
+
+typedef EpollSelect MultiSelect;
+#else
+typedef Select MultiSelect;
+#endif // USE_EPOLL
+
 static bool		accept_connection(rem_port*, const P_CNCT*);
 #ifdef HAVE_SETITIMER
 static void		alarm_handler(int);
@@ -565,9 +917,9 @@ static bool		packet_send(rem_port*, const SCHAR*, SSHORT);
 static rem_port*		receive(rem_port*, PACKET *);
 static rem_port*		select_accept(rem_port*);
 
-static void		select_port(rem_port*, Select*, RemPortPtr&);
+static void		select_port(rem_port*, MultiSelect*, RemPortPtr&);
 static bool		select_multi(rem_port*, UCHAR* buffer, SSHORT bufsize, SSHORT* length, RemPortPtr&);
-static bool		select_wait(rem_port*, Select*);
+static bool		select_wait(rem_port*, MultiSelect*);
 static int		send_full(rem_port*, PACKET *);
 static int		send_partial(rem_port*, PACKET *);
 
@@ -616,11 +968,10 @@ ULONG INET_remote_buffer;
 static GlobalPtr<Mutex> init_mutex;
 static volatile bool INET_initialized = false;
 static volatile bool INET_shutting_down = false;
-static GlobalPtr<Select> INET_select;
+static GlobalPtr<MultiSelect> INET_select;
 static rem_port* inet_async_receive = NULL;
 
 
-static GlobalPtr<Mutex> port_mutex;
 static GlobalPtr<PortsCleanup>	inet_ports;
 static GlobalPtr<SocketsArray> ports_to_close;
 
@@ -724,13 +1075,13 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 
 	cnct->p_cnct_count = FB_NELEM(protocols_to_try);
 
+	const USHORT compressFlags = compression ?
+		rem_port::checkCompression((*config)->getWireCompressionMethods()) : 0;
+
 	for (size_t i = 0; i < cnct->p_cnct_count; i++) {
 		cnct->p_cnct_versions[i] = protocols_to_try[i];
-		if (compression && cnct->p_cnct_versions[i].p_cnct_version >= PROTOCOL_VERSION13 &&
-			rem_port::checkCompression())
-		{
-			cnct->p_cnct_versions[i].p_cnct_max_type |= pflag_compress;
-		}
+		if (cnct->p_cnct_versions[i].p_cnct_version >= PROTOCOL_VERSION13)
+			cnct->p_cnct_versions[i].p_cnct_max_type |= compressFlags;
 	}
 
 	rem_port* port = inet_try_connect(packet, rdb, file_name, node_name, dpb, config, ref_db_name, af);
@@ -841,7 +1192,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 		port->port_flags |= PORT_symmetric;
 	}
 
-	const bool compress = accept->p_acpt_type & pflag_compress;
+	const USHORT compress = accept->p_acpt_type & pflag_compress_MASK;
 	accept->p_acpt_type &= ptype_MASK;
 
 	if (accept->p_acpt_type != ptype_out_of_band) {
@@ -854,7 +1205,7 @@ rem_port* INET_analyze(ClntAuthBlock* cBlock,
 
 	if (compress)
 	{
-		port->initCompression();
+		port->initCompression(compress);
 		port->port_flags |= PORT_compressed;
 	}
 
@@ -1172,6 +1523,9 @@ static rem_port* listener_socket(rem_port* port, USHORT flag, const addrinfo* pa
 		port->port_dummy_packet_interval = 0;
 		port->port_dummy_timeout = 0;
 		port->port_server_flags |= (SRVR_server | SRVR_multi_client);
+
+		MutexLockGuard guard(port_mutex, FB_FUNCTION);
+		INET_select->add(port);
 		return port;
 	}
 
@@ -1534,6 +1888,13 @@ static rem_port* aux_connect(rem_port* port, PACKET* packet)
 		port->port_handle = n;
 		port->port_flags |= PORT_async;
 
+		// Port linked to the multiclient listener is waited for by it
+		if (port->port_parent)
+		{
+			MutexLockGuard guard(port_mutex, FB_FUNCTION);
+			INET_select->add(port);
+		}
+
 		get_peer_info(port);
 
 		return port;
@@ -1785,6 +2146,8 @@ static void disconnect(rem_port* port)
 	// also select_wait() function.
 	const bool delayClose = (port->port_server_flags && port->port_parent);
 
+	INET_select->remove(port);
+
 	// If this is a sub-port, unlink it from its parent
 	port->unlinkParent();
 
@@ -1847,6 +2210,11 @@ static void force_close(rem_port* port)
 	if (port->port_state != rem_port::PENDING)
 		return;
 
+	{ // port_mutex scope
+		MutexLockGuard guard(port_mutex, FB_FUNCTION);
+		INET_select->remove(port);
+	}
+
 	RefMutexGuard guard(*port->port_write_sync, FB_FUNCTION);
 
 	port->port_state = rem_port::BROKEN;
@@ -2100,6 +2468,11 @@ static bool select_multi(rem_port* main_port, UCHAR* buffer, SSHORT bufsize, SSH
 				{
 					main_port->port_state = rem_port::BROKEN;
 
+					{ // port_mutex scope
+						MutexLockGuard guard(port_mutex, FB_FUNCTION);
+						INET_select->remove(main_port);
+					}
+
 					shutdown(main_port->port_handle, 2);
 					SOCLOSE(main_port->port_handle);
 				}
@@ -2184,10 +2557,12 @@ static rem_port* select_accept( rem_port* main_port)
 		return port;
 	}
 
+	MutexLockGuard guard(port_mutex, FB_FUNCTION);
+	INET_select->add(port);
 	return 0;
 }
 
-static void select_port(rem_port* main_port, Select* selct, RemPortPtr& port)
+static void select_port(rem_port* main_port, MultiSelect* selct, RemPortPtr& port)
 {
 /**************************************
  *
@@ -2237,7 +2612,7 @@ static void select_port(rem_port* main_port, Select* selct, RemPortPtr& port)
 	}
 }
 
-static bool select_wait( rem_port* main_port, Select* selct)
+static bool select_wait( rem_port* main_port, MultiSelect* selct)
 {
 /**************************************
  *
@@ -2282,6 +2657,31 @@ static bool select_wait( rem_port* main_port, Select* selct)
 				SOCLOSE(s);
 			}
 
+#ifdef USE_EPOLL
+			// Sockets stay in the epoll set until their ports are disconnected, so
+			// the ports are walked only when there are keepalive timers to adjust
+
+			// if process is shuting down - don't listen on main port
+			if (INET_shutting_down)
+				selct->remove(main_port);
+
+			if (delta_time)
+			{
+				for (rem_port* port = main_port; port; port = port->port_next)
+				{
+					if (port->port_state == rem_port::PENDING && port->port_dummy_packet_interval &&
+						!(port->port_handle == INVALID_SOCKET && (port->port_flags & PORT_async)))
+					{
+						port->port_dummy_timeout -= delta_time;
+
+						if (port->port_dummy_timeout < 0)
+							selct->check(port);
+					}
+				}
+			}
+
+			found = selct->hasPorts();
+#else
 			for (rem_port* port = main_port; port; port = port->port_next)
 			{
 				if (port->port_state == rem_port::PENDING &&
@@ -2322,7 +2722,7 @@ static bool select_wait( rem_port* main_port, Select* selct)
 								selct->clear();
 								if (!badSocket)
 								{
-									selct->set(port->port_handle);
+									selct->set(port);
 								}
 								return true;
 							}
@@ -2332,11 +2732,12 @@ static bool select_wait( rem_port* main_port, Select* selct)
 					// if process is shuting down - don't listen on main port
 					if (!INET_shutting_down || port != main_port)
 					{
-						selct->set(port->port_handle);
+						selct->set(port);
 						found = true;
 					}
 				}
 			}
+#endif
 			checkPorts = false;
 		} // port_mutex scope
 
@@ -2379,6 +2780,7 @@ static bool select_wait( rem_port* main_port, Select* selct)
 				// bit as this value is undefined on some platforms (eg. HP-UX),
 				// when the select call times out. Once these bits are cleared
 				// they can be used in select_port()
+#ifndef USE_EPOLL
 				if (selct->getCount() == 0)
 				{
 					MutexLockGuard guard(port_mutex, FB_FUNCTION);
@@ -2387,6 +2789,7 @@ static bool select_wait( rem_port* main_port, Select* selct)
 						selct->unset(port->port_handle);
 					}
 				}
+#endif
 				return true;
 			}
 			if (INTERRUPT_ERROR(inetErrNo))
@@ -154,6 +154,11 @@ constexpr USHORT ptype_MASK			= 0xFF;	// Mask - up to 255 types of protocol
 // upper byte is used for protocol flags
 constexpr USHORT pflag_compress			= 0x100;	// Turn on compression if possible
 constexpr USHORT pflag_win_sspi_nego	= 0x200;	// Win_SSPI supports Negotiate security package
+constexpr USHORT pflag_compress_lz4		= 0x400;	// LZ4 compression instead of zlib
+constexpr USHORT pflag_compress_zstd	= 0x800;	// Zstandard compression instead of zlib
+// In op_connect the client sets flags of all compression methods it supports,
+// the server answers with the single method chosen
+constexpr USHORT pflag_compress_MASK	= pflag_compress | pflag_compress_lz4 | pflag_compress_zstd;
 
 // Generic object id
 
@@ -566,6 +566,7 @@ void REMOTE_reset_statement( Rsr* statement)
 	statement->rsr_msgs_waiting = 0;
 	statement->rsr_reorder_level = 0;
 	statement->rsr_batch_count = 0;
+	statement->rsr_fetch_ahead = 0;
 
 	// only one entry
 
@@ -1519,6 +1520,385 @@ void rem_port::versionInfo(string& version) const
 
 #ifdef WIRE_COMPRESS_SUPPORT
 static InitInstance<ZLib> zlib;
+static InitInstance<LZ4> lz4;
+static InitInstance<ZStd> zstd;
+
+namespace {
+
+struct CompressionMethod
+{
+	const char* name;
+	USHORT flag;
+};
+
+const CompressionMethod compressionMethods[] =
+{
+	{"zlib", pflag_compress},
+	{"lz4", pflag_compress_lz4},
+	{"zstd", pflag_compress_zstd}
+};
+
+bool loadCompression(USHORT flag)
+{
+	switch (flag)
+	{
+	case pflag_compress:
+		return zlib();
+	case pflag_compress_lz4:
+		return lz4();
+	case pflag_compress_zstd:
+		return zstd();
+	}
+
+	return false;
+}
+
+// Get the methods listed in config which libraries are available, in the order of preference
+void listCompression(const char* methods, HalfStaticArray<USHORT, 4>& flags)
+{
+	ParsedList list(methods);
+
+	for (const auto& name : list)
+	{
+		for (const auto& method : compressionMethods)
+		{
+			if (name.equalsNoCase(method.name) && !flags.exist(method.flag) && loadCompression(method.flag))
+				flags.add(method.flag);
+		}
+	}
+}
+
+void advanceInput(z_stream& strm, size_t length)
+{
+	strm.next_in += length;
+	strm.avail_in -= (uInt) length;
+}
+
+
+// Output of a library kept until there is a room for it in the port buffer
+class StagedOutput
+{
+public:
+	explicit StagedOutput(MemoryPool& p)
+		: data(p)
+	{ }
+
+	bool isEmpty() const
+	{
+		return pos >= data.getCount();
+	}
+
+	UCHAR* reset(FB_SIZE_T capacity)
+	{
+		pos = 0;
+		return data.getBuffer(capacity);
+	}
+
+	void setLength(FB_SIZE_T length)
+	{
+		data.shrink(length);
+	}
+
+	void copyTo(z_stream& strm)
+	{
+		const FB_SIZE_T length = MIN(data.getCount() - pos, strm.avail_out);
+		memcpy(strm.next_out, data.begin() + pos, length);
+		pos += length;
+		strm.next_out += length;
+		strm.avail_out -= length;
+	}
+
+private:
+	UCharBuffer data;
+	FB_SIZE_T pos = 0;
+};
+
+
+class ZLibCodec final : public WireCodec
+{
+public:
+	ZLibCodec(z_stream& send, z_stream& recv)
+		: sendStream(send), recvStream(recv)
+	{
+		sendStream.zalloc = ZLib::allocFunc;
+		sendStream.zfree = ZLib::freeFunc;
+		sendStream.opaque = Z_NULL;
+		int ret = zlib().deflateInit(&sendStream, Z_DEFAULT_COMPRESSION);
+		if (ret != Z_OK)
+			(Arg::Gds(isc_deflate_init) << Arg::Num(0)).raise();
+
+		recvStream.zalloc = ZLib::allocFunc;
+		recvStream.zfree = ZLib::freeFunc;
+		recvStream.opaque = Z_NULL;
+		ret = zlib().inflateInit(&recvStream);
+		if (ret != Z_OK)
+		{
+			zlib().deflateEnd(&sendStream);
+			(Arg::Gds(isc_inflate_init) << Arg::Num(ret)).raise();
+		}
+	}
+
+	~ZLibCodec()
+	{
+		zlib().deflateEnd(&sendStream);
+		zlib().inflateEnd(&recvStream);
+	}
+
+	bool deflate(z_stream& strm, bool flush) override
+	{
+		const int ret = zlib().deflate(&strm, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+#ifdef COMPRESS_DEBUG
+		if (ret != Z_OK && ret != Z_BUF_ERROR)
+			fprintf(stderr, "Deflate error %d\n", ret);
+#endif
+		return ret == Z_OK || ret == Z_BUF_ERROR;
+	}
+
+	bool inflate(z_stream& strm) override
+	{
+		return zlib().inflate(&strm, Z_NO_FLUSH) == Z_OK;
+	}
+
+private:
+	z_stream& sendStream;
+	z_stream& recvStream;
+};
+
+
+// LZ4 and Zstandard may keep decompressed data inside until there is a room for them
+// in the output buffer, without consuming any more input. To know exactly when the
+// port has data left to process, the output is staged in a buffer of our own.
+class StagedCodec : public WireCodec
+{
+public:
+	bool inflate(z_stream& strm) override
+	{
+		for (;;)
+		{
+			recvOut.copyTo(strm);
+
+			if (!recvOut.isEmpty() || !(strm.avail_in || more))
+				return true;
+
+			const uInt available = strm.avail_in;
+			size_t produced = STAGE_SIZE;
+
+			if (!decompress(strm, recvOut.reset(STAGE_SIZE), produced))
+			{
+				recvOut.setLength(0);
+				return false;
+			}
+
+			recvOut.setLength(produced);
+			more = (produced == STAGE_SIZE);
+
+			if (!produced && strm.avail_in == available)
+				return true;		// more input is needed
+		}
+	}
+
+	bool hasPending() const override
+	{
+		return !recvOut.isEmpty();
+	}
+
+protected:
+	static constexpr FB_SIZE_T STAGE_SIZE = 32768;
+
+	explicit StagedCodec(MemoryPool& p)
+		: recvOut(p)
+	{ }
+
+	// Decompress from strm input to the buffer of given size
+	virtual bool decompress(z_stream& strm, UCHAR* buffer, size_t& length) = 0;
+
+private:
+	StagedOutput recvOut;
+	bool more = false;		// the library may have more output
+};
+
+
+class LZ4Codec final : public StagedCodec
+{
+public:
+	explicit LZ4Codec(MemoryPool& p)
+		: StagedCodec(p), sendOut(p)
+	{
+		size_t ret = lz4().LZ4F_createCompressionContext(&compressor, LZ4::VERSION);
+		if (lz4().LZ4F_isError(ret))
+			(Arg::Gds(isc_deflate_init) << Arg::Num((SLONG) ret)).raise();
+
+		ret = lz4().LZ4F_createDecompressionContext(&decompressor, LZ4::VERSION);
+		if (lz4().LZ4F_isError(ret))
+		{
+			lz4().LZ4F_freeCompressionContext(compressor);
+			(Arg::Gds(isc_inflate_init) << Arg::Num((SLONG) ret)).raise();
+		}
+	}
+
+	~LZ4Codec()
+	{
+		lz4().LZ4F_freeCompressionContext(compressor);
+		lz4().LZ4F_freeDecompressionContext(decompressor);
+	}
+
+	// LZ4 can't write less than a whole block, so compressed data are staged too
+	bool deflate(z_stream& strm, bool flush) override
+	{
+		for (;;)
+		{
+			sendOut.copyTo(strm);
+
+			if (!sendOut.isEmpty())
+				return true;		// port buffer is full
+
+			size_t ret;
+
+			if (!started)
+			{
+				ret = lz4().LZ4F_compressBegin(compressor, sendOut.reset(LZ4::HEADER_SIZE_MAX),
+					LZ4::HEADER_SIZE_MAX, nullptr);
+				started = true;
+			}
+			else if (strm.avail_in)
+			{
+				const size_t length = MIN(strm.avail_in, STAGE_SIZE);
+				const size_t bound = lz4().LZ4F_compressBound(length, nullptr);
+
+				ret = lz4().LZ4F_compressUpdate(compressor, sendOut.reset(bound), bound,
+					strm.next_in, length, nullptr);
+
+				if (!lz4().LZ4F_isError(ret))
+					advanceInput(strm, length);
+			}
+			else if (flush)
+			{
+				const size_t bound = lz4().LZ4F_compressBound(0, nullptr);
+				ret = lz4().LZ4F_flush(compressor, sendOut.reset(bound), bound, nullptr);
+
+				if (!ret)
+				{
+					sendOut.setLength(0);
+					return true;
+				}
+			}
+			else
+				return true;
+
+			if (lz4().LZ4F_isError(ret))
+			{
+				sendOut.setLength(0);
+				return false;
+			}
+
+			sendOut.setLength(ret);
+		}
+	}
+
+protected:
+	bool decompress(z_stream& strm, UCHAR* buffer, size_t& length) override
+	{
+		size_t consumed = strm.avail_in;
+		const size_t ret = lz4().LZ4F_decompress(decompressor, buffer, &length,
+			strm.next_in, &consumed, nullptr);
+
+		if (lz4().LZ4F_isError(ret))
+			return false;
+
+		advanceInput(strm, consumed);
+		return true;
+	}
+
+private:
+	LZ4::Compressor* compressor = nullptr;
+	LZ4::Decompressor* decompressor = nullptr;
+	StagedOutput sendOut;
+	bool started = false;	// frame header is written
+};
+
+
+// Compressor of every connection is limited to the fastest level and a small
+// window, library defaults would take several megabytes per connection. The
+// decompressor buffers the window chosen by the other side's compressor.
+
+class ZStdCodec final : public StagedCodec
+{
+	static constexpr int COMPRESSION_LEVEL = 1;
+	static constexpr int WINDOW_LOG = 17;		// 128KB
+
+public:
+	explicit ZStdCodec(MemoryPool& p)
+		: StagedCodec(p)
+	{
+		const ZStd::CustomMem mem = {ZStd::allocFunc, ZStd::freeFunc, nullptr};
+
+		compressor = zstd().ZSTD_createCCtx_advanced(mem);
+		if (!compressor)
+			(Arg::Gds(isc_deflate_init) << Arg::Num(0)).raise();
+
+		size_t ret = zstd().ZSTD_CCtx_setParameter(compressor, ZStd::C_COMPRESSION_LEVEL, COMPRESSION_LEVEL);
+		if (!zstd().ZSTD_isError(ret))
+			ret = zstd().ZSTD_CCtx_setParameter(compressor, ZStd::C_WINDOW_LOG, WINDOW_LOG);
+
+		if (zstd().ZSTD_isError(ret))
+		{
+			zstd().ZSTD_freeCCtx(compressor);
+			(Arg::Gds(isc_deflate_init) << Arg::Num(0)).raise();
+		}
+
+		decompressor = zstd().ZSTD_createDCtx_advanced(mem);
+		if (!decompressor)
+		{
+			zstd().ZSTD_freeCCtx(compressor);
+			(Arg::Gds(isc_inflate_init) << Arg::Num(0)).raise();
+		}
+	}
+
+	~ZStdCodec()
+	{
+		zstd().ZSTD_freeCCtx(compressor);
+		zstd().ZSTD_freeDCtx(decompressor);
+	}
+
+	bool deflate(z_stream& strm, bool flush) override
+	{
+		ZStd::InBuffer in = {strm.next_in, strm.avail_in, 0};
+		ZStd::OutBuffer out = {strm.next_out, strm.avail_out, 0};
+
+		const size_t ret = zstd().ZSTD_compressStream2(compressor, &out, &in,
+			flush ? ZStd::E_FLUSH : ZStd::E_CONTINUE);
+
+		if (zstd().ZSTD_isError(ret))
+			return false;
+
+		advanceInput(strm, in.pos);
+		strm.next_out += out.pos;
+		strm.avail_out -= (uInt) out.pos;
+		return true;
+	}
+
+protected:
+	bool decompress(z_stream& strm, UCHAR* buffer, size_t& length) override
+	{
+		ZStd::InBuffer in = {strm.next_in, strm.avail_in, 0};
+		ZStd::OutBuffer out = {buffer, length, 0};
+
+		const size_t ret = zstd().ZSTD_decompressStream(decompressor, &out, &in);
+
+		if (zstd().ZSTD_isError(ret))
+			return false;
+
+		advanceInput(strm, in.pos);
+		length = out.pos;
+		return true;
+	}
+
+private:
+	ZStd::Compressor* compressor = nullptr;
+	ZStd::Decompressor* decompressor = nullptr;
+};
+
+} // anonymous namespace
 #endif // WIRE_COMPRESS_SUPPORT
 
 rem_port::~rem_port()
@@ -1547,11 +1927,7 @@ rem_port::~rem_port()
 #endif
 
 #ifdef WIRE_COMPRESS_SUPPORT
-	if (port_compressed)
-	{
-		zlib().deflateEnd(&port_send_stream);
-		zlib().inflateEnd(&port_recv_stream);
-	}
+	port_codec.reset();
 #endif
 }
 
@@ -1571,9 +1947,11 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 	strm.avail_out = buffer_length;
 	strm.next_out = buffer;
 
+	WireCodec* const codec = port->port_codec;
+
 	for (;;)
 	{
-		if (strm.avail_in)
+		if (strm.avail_in || codec->hasPending())
 		{
 #ifdef COMPRESS_DEBUG
 			fprintf(stderr, "Data to inflate %d port %p\n", strm.avail_in, port);
@@ -1583,7 +1961,7 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 #endif
 #endif
 
-			if (zlib().inflate(&strm, Z_NO_FLUSH) != Z_OK)
+			if (!codec->inflate(strm))
 			{
 #ifdef COMPRESS_DEBUG
 				fprintf(stderr, "Inflate error\n");
@@ -1628,7 +2006,8 @@ bool REMOTE_inflate(rem_port* port, PacketReceive* packet_receive, UCHAR* buffer
 	}
 
 	*length = (SSHORT) (buffer_length - strm.avail_out);
-	if (strm.avail_in)	// Z-buffer still has some data - probably can call inflate() once more on them
+	// Z-buffer still has some data - probably can call inflate() once more on them
+	if (strm.avail_in || codec->hasPending())
 		port->port_z_data = true;
 	else
 		port->port_z_data = false;
@@ -1677,16 +2056,8 @@ bool REMOTE_deflate(RemoteXdr* xdrs, ProtoWrite* proto_write, PacketSend* packet
 		fprintf(stderr, "\n");
 #endif
 #endif
-		int ret = zlib().deflate(&strm, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
-		if (ret == Z_BUF_ERROR)
-			ret = 0;
-		if (ret != 0)
-		{
-#ifdef COMPRESS_DEBUG
-			fprintf(stderr, "Deflate error %d\n", ret);
-#endif
+		if (!port->port_codec->deflate(strm, flush))
 			return false;
-		}
 
 #ifdef COMPRESS_DEBUG
 		fprintf(stderr, "Deflated data %d\n", port->port_buff_size - strm.avail_out);
@@ -1723,58 +2094,106 @@ bool REMOTE_deflate(RemoteXdr* xdrs, ProtoWrite* proto_write, PacketSend* packet
 #endif
 }
 
-bool rem_port::checkCompression()
+USHORT rem_port::checkCompression(const char* methods)
 {
+/**************************************
+ *
+ *	c h e c k C o m p r e s s i o n
+ *
+ **************************************
+ *
+ * Functional description
+ *	Return flags of compression methods listed which
+ *	libraries are available, to be sent in op_connect.
+ *
+ **************************************/
+	USHORT result = 0;
+
 #ifdef WIRE_COMPRESS_SUPPORT
-	return zlib();
-#else
-	return false;
+	HalfStaticArray<USHORT, 4> flags;
+	listCompression(methods, flags);
+
+	for (const auto flag : flags)
+		result |= flag;
 #endif
+
+	return result;
 }
 
-void rem_port::initCompression()
+USHORT rem_port::selectCompression(USHORT cnctType, const char* methods)
 {
+/**************************************
+ *
+ *	s e l e c t C o m p r e s s i o n
+ *
+ **************************************
+ *
+ * Functional description
+ *	Choose the compression method from the ones supported by client
+ *	in the order of server preference. Old clients know zlib only.
+ *
+ **************************************/
 #ifdef WIRE_COMPRESS_SUPPORT
-	if (port_protocol >= PROTOCOL_VERSION13 && !port_compressed && zlib())
+	HalfStaticArray<USHORT, 4> flags;
+	listCompression(methods, flags);
+
+	for (const auto flag : flags)
 	{
-		port_send_stream.zalloc = ZLib::allocFunc;
-		port_send_stream.zfree = ZLib::freeFunc;
-		port_send_stream.opaque = Z_NULL;
-		int ret = zlib().deflateInit(&port_send_stream, Z_DEFAULT_COMPRESSION);
-		if (ret != Z_OK)
-			(Arg::Gds(isc_deflate_init) << Arg::Num(ret)).raise();
-		port_send_stream.next_out = NULL;
-
-		port_recv_stream.zalloc = ZLib::allocFunc;
-		port_recv_stream.zfree = ZLib::freeFunc;
-		port_recv_stream.opaque = Z_NULL;
-		port_recv_stream.avail_in = 0;
-		port_recv_stream.next_in = Z_NULL;
-		ret = zlib().inflateInit(&port_recv_stream);
-		if (ret != Z_OK)
-		{
-			zlib().deflateEnd(&port_send_stream);
-			(Arg::Gds(isc_inflate_init) << Arg::Num(ret)).raise();
-		}
+		if (cnctType & flag)
+			return flag;
+	}
+#endif
 
-		try
-		{
-			port_compressed.reset(FB_NEW_POOL(getPool()) UCHAR[port_buff_size * 2]);
-		}
-		catch (const Exception&)
-		{
-			zlib().deflateEnd(&port_send_stream);
-			zlib().inflateEnd(&port_recv_stream);
-			throw;
-		}
+	return 0;
+}
+
+void rem_port::initCompression(USHORT acptType)
+{
+#ifdef WIRE_COMPRESS_SUPPORT
+	if (port_protocol < PROTOCOL_VERSION13 || port_compressed)
+		return;
+
+	const USHORT method = acptType & pflag_compress_MASK;
+	if (!loadCompression(method))
+		return;
 
-		memset(port_compressed, 0, port_buff_size * 2);
-		port_recv_stream.next_in = &port_compressed[REM_RECV_OFFSET(port_buff_size)];
+	memset(&port_send_stream, 0, sizeof(port_send_stream));
+	memset(&port_recv_stream, 0, sizeof(port_recv_stream));
+
+	switch (method)
+	{
+	case pflag_compress:
+		port_codec = FB_NEW_POOL(getPool()) ZLibCodec(port_send_stream, port_recv_stream);
+		break;
+
+	case pflag_compress_lz4:
+		port_codec = FB_NEW_POOL(getPool()) LZ4Codec(getPool());
+		break;
+
+	case pflag_compress_zstd:
+		port_codec = FB_NEW_POOL(getPool()) ZStdCodec(getPool());
+		break;
+	}
+
+	port_send_stream.next_out = NULL;
+
+	try
+	{
+		port_compressed.reset(FB_NEW_POOL(getPool()) UCHAR[port_buff_size * 2]);
+	}
+	catch (const Exception&)
+	{
+		port_codec.reset();
+		throw;
+	}
+
+	memset(port_compressed, 0, port_buff_size * 2);
+	port_recv_stream.avail_in = 0;
+	port_recv_stream.next_in = &port_compressed[REM_RECV_OFFSET(port_buff_size)];
 
 #ifdef COMPRESS_DEBUG
-		fprintf(stderr, "Completed init port %p\n", this);
+	fprintf(stderr, "Completed init port %p\n", this);
 #endif
-	}
 #endif
 }
 
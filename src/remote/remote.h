@@ -63,6 +63,23 @@
 #define WIRE_COMPRESS_SUPPORT 1
 //#define COMPRESS_DEBUG 1
 #include "../common/classes/zip.h"
+
+// Stream compression algorithm used on the wire. Whatever algorithm is used,
+// positions in the data are passed in next/avail fields of z_stream.
+class WireCodec
+{
+public:
+	virtual ~WireCodec() { }
+
+	virtual bool deflate(z_stream& strm, bool flush) = 0;
+	virtual bool inflate(z_stream& strm) = 0;
+
+	// Decompressed data are kept inside the codec
+	virtual bool hasPending() const
+	{
+		return false;
+	}
+};
 #endif
 
 #define DEB_RBATCH(x)	((void) 0)
@@ -665,6 +682,7 @@ struct Rsr : public Firebird::GlobalStorage, public TypedHandle<rem_type_rsr>
 	USHORT			rsr_msgs_waiting; 	// count of full rsr_messages
 	USHORT			rsr_reorder_level; 	// Trigger pipelining at this level
 	USHORT			rsr_batch_count; 	// Count of batches in pipeline
+	ULONG			rsr_fetch_ahead;	// Rows to be requested beyond the reorder level
 
 	Firebird::string rsr_cursor_name;	// Name for cursor to be set on open
 	bool			rsr_delayed_format;	// Out format was delayed on execute, set it on fetch
@@ -734,6 +752,7 @@ public:
 		rsr_format(0), rsr_message(0), rsr_buffer(0), rsr_status(0),
 		rsr_id(0), rsr_fmt_length(0),
 		rsr_rows_pending(0), rsr_msgs_waiting(0), rsr_reorder_level(0), rsr_batch_count(0),
+		rsr_fetch_ahead(0),
 		rsr_cursor_name(getPool()), rsr_delayed_format(false), rsr_timeout(0), rsr_self(NULL),
 		rsr_batch_size(0), rsr_batch_flags(0), rsr_batch_ics(NULL),
 		rsr_fetch_operation(fetch_next), rsr_fetch_position(0), rsr_inline_blob_size(0)
@@ -1310,7 +1329,7 @@ struct rem_port : public Firebird::GlobalStorage, public Firebird::RefCounted
 	USHORT			port_flags;			// Misc flags
 	std::atomic<bool>
 					port_partial_data,	// Physical packet doesn't contain all API packet
-					port_z_data;		// Zlib incoming buffer has data left after decompression
+					port_z_data;		// Compressed incoming buffer has data left after decompression
 	SLONG			port_connect_timeout;   // Connection timeout value
 	SLONG			port_dummy_packet_interval; // keep alive dummy packet interval
 	SLONG			port_dummy_timeout;	// time remaining until keepalive packet
@@ -1467,6 +1486,7 @@ public:
 #ifdef WIRE_COMPRESS_SUPPORT
 	z_stream port_send_stream, port_recv_stream;
 	UCharArrayAutoPtr	port_compressed;
+	Firebird::AutoPtr<WireCodec> port_codec;	// compression method chosen for the port
 #endif
 
 public:
@@ -1526,8 +1546,9 @@ private:
 	friend class Firebird::RefPtr<rem_port>;
 
 public:
-	void initCompression();
-	static bool checkCompression();
+	void initCompression(USHORT acptType);
+	static USHORT checkCompression(const char* methods);
+	static USHORT selectCompression(USHORT cnctType, const char* methods);
 	void linkParent(rem_port* const parent);
 	void unlinkParent();
 	Firebird::RefPtr<const Firebird::Config> getPortConfig();
@@ -391,6 +391,11 @@ int CLIB_ROUTINE main( int argc, char** argv)
 			exit(STARTUP_ERROR);
 		}
 
+		// Engine threads, including parallel workers, inherit process affinity
+		const FB_UINT64 affinity = Config::getCpuAffinityMask();
+		if (affinity)
+			os_utils::setAffinity(affinity);
+
 		if (!debug)
 		{
 			const char* redirection_file = Config::getOutputRedirectionFile();
@@ -795,10 +795,10 @@ public:
 					}
 				}
 
-				if (send->p_acpt.p_acpt_type & pflag_compress)
-					authPort->initCompression();
+				if (send->p_acpt.p_acpt_type & pflag_compress_MASK)
+					authPort->initCompression(send->p_acpt.p_acpt_type);
 				authPort->send(send);
-				if (send->p_acpt.p_acpt_type & pflag_compress)
+				if (send->p_acpt.p_acpt_type & pflag_compress_MASK)
 					authPort->port_flags |= PORT_compressed;
 				memset(&send->p_auth_cont, 0, sizeof send->p_auth_cont);
 
@@ -2009,7 +2009,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 	P_ARCH architecture = arch_generic;
 	USHORT version = 0;
 	USHORT type = 0;
-	bool compress = false;
+	USHORT compress = 0;
 	bool accepted = false;
 	USHORT weight = 0;
 	const p_cnct::p_cnct_repeat* protocol = connect->p_cnct_versions;
@@ -2029,16 +2029,19 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 			version = protocol->p_cnct_version;
 			architecture = protocol->p_cnct_architecture;
 			type = MIN(protocol->p_cnct_max_type & ptype_MASK, ptype_lazy_send);
-			compress = protocol->p_cnct_max_type & pflag_compress;
+			compress = protocol->p_cnct_max_type & pflag_compress_MASK;
 		}
 	}
 
+	if (compress)
+		compress = rem_port::selectCompression(compress, port->getPortConfig()->getWireCompressionMethods());
+
 	HANDSHAKE_DEBUG(fprintf(stderr, "Srv: accept_connection: protoaccept a=%d (v>=13)=%d %d %d\n",
 					accepted, version >= PROTOCOL_VERSION13, version, PROTOCOL_VERSION13));
 
 	send->p_acpd.p_acpt_version = port->port_protocol = version;
 	send->p_acpd.p_acpt_architecture = architecture;
-	send->p_acpd.p_acpt_type = type | (compress ? pflag_compress : 0);
+	send->p_acpd.p_acpt_type = type | compress;
 #ifdef TRUSTED_AUTH
 	send->p_acpd.p_acpt_type |= pflag_win_sspi_nego;
 #endif
@@ -2046,7 +2049,7 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 
 	send->p_acpt.p_acpt_version = port->port_protocol = version;
 	send->p_acpt.p_acpt_architecture = architecture;
-	send->p_acpt.p_acpt_type = type | (compress ? pflag_compress : 0);
+	send->p_acpt.p_acpt_type = type | compress;
 
 	// modify the version string to reflect the chosen protocol
 	string buffer;
@@ -2239,10 +2242,10 @@ static bool accept_connection(rem_port* port, P_CNCT* connect, PACKET* send)
 	HANDSHAKE_DEBUG(fprintf(stderr, "Srv: accept_connection: accepted ud=%d protocol=%x\n", returnData, port->port_protocol));
 
 	send->p_operation = returnData ? op_accept_data : op_accept;
-	if (send->p_acpt.p_acpt_type & pflag_compress)
-		port->initCompression();
+	if (send->p_acpt.p_acpt_type & pflag_compress_MASK)
+		port->initCompression(send->p_acpt.p_acpt_type);
 	port->send(send);
-	if (send->p_acpt.p_acpt_type & pflag_compress)
+	if (send->p_acpt.p_acpt_type & pflag_compress_MASK)
 		port->port_flags |= PORT_compressed;
 
 	return true;
@@ -2268,10 +2271,10 @@ void ConnectAuth::accept(PACKET* send, Auth::WriterImplementation*)
 		CSTRING* const s = &send->p_acpd.p_acpt_keys;
 		authPort->extractNewKeys(s);
 		send->p_acpd.p_acpt_authenticated = 1;
-		if (send->p_acpt.p_acpt_type & pflag_compress)
-			authPort->initCompression();
+		if (send->p_acpt.p_acpt_type & pflag_compress_MASK)
+			authPort->initCompression(send->p_acpt.p_acpt_type);
 		authPort->send(send);
-		if (send->p_acpt.p_acpt_type & pflag_compress)
+		if (send->p_acpt.p_acpt_type & pflag_compress_MASK)
 			authPort->port_flags |= PORT_compressed;
 	}
 }
@@ -4365,6 +4368,20 @@ ISC_STATUS rem_port::fetch(P_SQLDATA * sqldata, PACKET* sendL, bool scroll)
 
 	USHORT prefetch_count = (success && prefetch) ? count : 0;
 
+	// If the client is allowed to request more batches ahead, keep up to that many
+	// batches ready for it, so that its requests are served without waiting for
+	// the access method.
+
+	const ULONG fetch_ahead = getPortConfig()->getRemoteFetchAhead();
+
+	if (prefetch_count && fetch_ahead > 1)
+	{
+		const ULONG ready = (ULONG) count * fetch_ahead;
+
+		prefetch_count = (ready > statement->rsr_msgs_waiting) ?
+			(USHORT) MIN(ready - statement->rsr_msgs_waiting, MAX_USHORT) : 0;
+	}
+
 	for (; prefetch_count; --prefetch_count)
 	{
 		if (message->msg_address)
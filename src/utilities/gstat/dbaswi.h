@@ -51,6 +51,8 @@ const int IN_SW_DBA_FETCH_PASS		= 14;	// fetch password from file
 const int IN_SW_DBA_ENCRYPTION		= 15;	// analyze pages encryption
 const int IN_SW_DBA_HELP			= 16;	// show help
 const int IN_SW_DBA_ROLE			= 17;	// SQL role
+const int IN_SW_DBA_PARALLEL		= 18;	// parallel collection threads
+const int IN_SW_DBA_SAMPLE			= 19;	// sample percentage of pages
 
 const static struct Switches::in_sw_tab_t dba_in_sw_table[] =
 {
@@ -60,8 +62,10 @@ const static struct Switches::in_sw_tab_t dba_in_sw_table[] =
     {IN_SW_DBA_HEADER,			isc_spb_sts_hdr_pages,		"HEADER",	0,0,0,	false,	true,	24,	1, NULL},	// msg 24: -h      analyze header page
     {IN_SW_DBA_INDEX,			isc_spb_sts_idx_pages,		"INDEX",	0,0,0,	false,	true,	25,	1, NULL},	// msg 25: -i      analyze index leaf pages
 //  {IN_SW_DBA_LOG,				isc_spb_sts_db_log,			"LOG",		0,0,0,	false,	true,	26,	1, NULL},	// msg 26: -l      analyze log page
+    {IN_SW_DBA_SAMPLE,			0,							"SAMPLE",	0,0,0,	false,	false,	66,	2, NULL},	// msg 66: -sa     percentage of pages to sample
     {IN_SW_DBA_SYSTEM,			isc_spb_sts_sys_relations,	"SYSTEM",	0,0,0,	false,	true,	27,	1, NULL},	// msg 27: -s      analyze system relations
     {IN_SW_DBA_USERNAME,		0,							"USERNAME",	0,0,0,	false,	false,	32,	1, NULL},	// msg 32: -u      username
+    {IN_SW_DBA_PARALLEL,		0,							"PARALLEL",	0,0,0,	false,	false,	65,	3, NULL},	// msg 65: -par    number of parallel threads
     {IN_SW_DBA_PASSWORD,		0,							"PASSWORD",	0,0,0,	false,	false,	33,	1, NULL},	// msg 33: -p      password
     {IN_SW_DBA_FETCH_PASS,		0,					"FETCH_PASSWORD",	0,0,0,	false,	false,	37,	2, NULL},	// msg 37: -fetch  fetch password from file
     {IN_SW_DBA_RECORD,			isc_spb_sts_record_versions,"RECORD",	0,0,0,	false,	true,	34,	1, NULL},	// msg 34: -r      analyze average record and version length